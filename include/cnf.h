@@ -29,9 +29,35 @@ struct SATNode {
 struct SATList {
     SATNode* head;             // 指向子句中第一个文字节点
     SATList* next;             // 指向下一个子句
+    SATList* prev;             // 指向前一个子句（O(1)删除用）
 };
 // ==================== 函数声明 ====================
 
+// ---------- 节点池分配器 ----------
+// SATNode/SATList从slab（64KB起倍增至2MB）中成块分配，释放的节点进入自由链表
+// 复用，取代逐节点malloc/free（每节点省去约16字节分配器头开销，
+// 且读入/复制公式时不再有2N次malloc调用）
+
+/**
+ * @brief 从节点池分配一个文字节点
+ */
+SATNode* allocNode();
+
+/**
+ * @brief 从节点池分配一个子句节点
+ */
+SATList* allocList();
+
+/**
+ * @brief 将文字节点归还节点池
+ */
+void freeNode(SATNode* node);
+
+/**
+ * @brief 将子句节点归还节点池
+ */
+void freeList(SATList* clause);
+
 // ---------- SAT求解器核心函数 ----------
 
 /**
@@ -108,6 +134,45 @@ SATNode* unitClause(SATList* cnf);
  */
 int DPLL(SATList*& cnf, int value[]);
 
+// ==================== 增量求解接口 ====================
+
+struct IncrementalSolver;   ///< 增量求解器（不透明句柄，实现见cnf.cpp）
+
+/**
+ * @brief 创建增量求解器并载入初始公式
+ * @param cnf CNF公式链表（只读）
+ * @return 求解器句柄，用毕须incrementalDestroy释放
+ * @details 同一实例跨多次incrementalSolve保留学习子句与启发式状态，
+ *          适合"结构不变、条件多变"的反复求解（如挖洞唯一性检查）
+ */
+IncrementalSolver* incrementalCreate(SATList* cnf);
+
+/**
+ * @brief 分配一个新变量（如子句的激活文字）
+ * @return 新变量编号
+ */
+int incrementalNewVar(IncrementalSolver* solver);
+
+/**
+ * @brief 向求解器层0追加子句
+ * @param literals 子句文字数组
+ * @param count 文字个数
+ * @return 成功返回1，子句使公式矛盾返回0
+ */
+int incrementalAddClause(IncrementalSolver* solver, const int literals[], int count);
+
+/**
+ * @brief 在给定假设文字下求解
+ * @param assumptions 假设文字数组，求解结束自动撤销
+ * @param count 假设个数
+ * @param value 变量赋值数组（输出参数，仅有解时写入）
+ * @return 有解返回1，当前假设下无解返回0
+ */
+int incrementalSolve(IncrementalSolver* solver, const int assumptions[], int count, int value[]);
+
+/** @brief 释放增量求解器 */
+void incrementalDestroy(IncrementalSolver* solver);
+
 /**
  * @brief 深拷贝CNF公式链表
  * @param a 目标链表（输出参数）
@@ -126,6 +191,93 @@ int WriteFile(int result, double time, int value[]);
 
 // ==================== 高效数据结构定义 ====================
 
+/**
+ * @brief 扁平化CNF公式存储（CSR布局）
+ * @details 用两个连续数组取代SATNode/SATList链表：
+ *          - lits: 所有子句的文字依次拼接存放
+ *          - off:  第i个子句的文字区间为 lits[off[i]..off[i+1])
+ *          相比链表，每个文字只占4字节且内存连续，
+ *          遍历子句时缓存友好，整个公式只需2次堆分配
+ */
+struct CNFArena {
+    std::vector<int> lits;          ///< 所有文字的连续存储
+    std::vector<uint32_t> off;      ///< 子句偏移数组，长度为子句数+1
+
+    CNFArena() { off.push_back(0); }
+
+    /** @brief 返回子句数量 */
+    int clauseNum() const { return (int)off.size() - 1; }
+
+    /** @brief 开始追加一个新子句（随后用pushLiteral添加文字） */
+    void beginClause() {}
+
+    /** @brief 向当前子句追加一个文字 */
+    void pushLiteral(int literal) { lits.push_back(literal); }
+
+    /** @brief 结束当前子句，记录偏移 */
+    void endClause() { off.push_back((uint32_t)lits.size()); }
+
+    /** @brief 清空公式 */
+    void clear() { lits.clear(); off.assign(1, 0); }
+
+    /**
+     * @brief 从传统链表结构转换（兼容旧调用者）
+     */
+    void fromSATList(SATList* cnf);
+
+    /**
+     * @brief 转换回传统链表结构（兼容旧调用者）
+     */
+    SATList* toSATList() const;
+};
+
+/**
+ * @brief 从CNF文件直接读入扁平存储
+ * @param arena 输出参数，存储读取的CNF公式
+ * @return 成功返回1，失败返回0
+ */
+int ReadFile(CNFArena& arena);
+
+/**
+ * @brief 在给定赋值下计算扁平存储中某个子句的真值
+ * @param arena CNF公式
+ * @param clauseIdx 子句下标
+ * @param v 变量赋值数组
+ * @return 子句为真返回1，为假返回0
+ */
+int evaluateClause(const CNFArena& arena, int clauseIdx, int v[]);
+
+/**
+ * @brief 检查扁平存储的CNF公式中是否包含空子句
+ * @param arena CNF公式
+ * @return 包含空子句返回1，否则返回0
+ */
+int emptyClause(const CNFArena& arena);
+
+/**
+ * @brief 寻找扁平存储的CNF公式中的单子句
+ * @param arena CNF公式
+ * @return 找到单子句返回其首文字，否则返回0
+ */
+int unitClause(const CNFArena& arena);
+
+/**
+ * @brief 判断扁平存储中某个子句是否为单子句
+ * @param arena CNF公式
+ * @param clauseIdx 子句下标
+ * @return 是单子句返回1，否则返回0
+ * @details CSR布局下长度即相邻偏移之差，无需遍历文字
+ */
+int isUnitClause(const CNFArena& arena, int clauseIdx);
+
+/**
+ * @brief 深拷贝扁平存储的CNF公式
+ * @param a 目标公式（输出参数）
+ * @param b 源公式
+ * @details 仅两次vector整体复制，无逐节点分配
+ */
+void CopyClause(CNFArena& a, const CNFArena& b);
+
 /**
  * @brief 变量状态枚举
  */
@@ -135,30 +287,94 @@ enum VarState {
     VAR_TRUE = 1
 };
 
-/**
- * @brief 回溯栈项目，记录每次赋值操作
- */
-struct TrailItem {
-    int var;                    ///< 被赋值的变量
-    VarState old_value;         ///< 变量的旧值
-    int decision_level;         ///< 决策层级
-    bool is_decision;           ///< 是否为决策变量（非传播）
-};
-
 /**
  * @brief 高效CNF公式表示
  */
 class FastCNF {
 public:
-    std::vector<std::vector<int>> clauses;      ///< 子句集合，每个子句是文字数组
-    std::vector<VarState> assignment;           ///< 变量赋值状态
-    std::vector<TrailItem> trail;               ///< 回溯栈
+    // 子句集合采用CSR扁平布局（与CNFArena一致）：
+    // 所有文字顺序拼接在lits中，第i个子句为lits[off[i]..off[i+1])。
+    // 相比vector<vector<int>>免去每子句一次堆分配与一层指针间接，
+    // 全量扫描（hasEmptyClause/allClausesSatisfied/unitPropagate）
+    // 变为纯顺序访问，copy()也只是两次vector整体复制
+    std::vector<int> lits;                      ///< 所有子句文字的连续存储
+    std::vector<uint32_t> off;                  ///< 子句偏移数组，长度为子句数+1
+
+    /** @brief 返回子句数量 */
+    int clauseNum() const { return (int)off.size() - 1; }
+
+    // 赋值状态打包为两个位集，每变量各占1位：
+    // assigned_bits记录是否已赋值，value_bits记录取值（仅已赋值时有效）。
+    // 相比每变量4字节的枚举数组，扫描时内存流量降低约32倍
+    std::vector<uint64_t> assigned_bits;        ///< 变量是否已赋值位集
+    std::vector<uint64_t> value_bits;           ///< 变量取值位集
+
+    /** @brief 变量是否已赋值 */
+    bool isAssigned(int var) const {
+        return (assigned_bits[var >> 6] >> (var & 63)) & 1;
+    }
+
+    /** @brief 读取变量状态 */
+    VarState varValue(int var) const {
+        if (!isAssigned(var)) return VAR_UNASSIGNED;
+        return ((value_bits[var >> 6] >> (var & 63)) & 1) ? VAR_TRUE : VAR_FALSE;
+    }
+
+    /** @brief 文字在当前赋值下是否为真 */
+    bool litIsTrue(int lit) const {
+        int var = lit > 0 ? lit : -lit;
+        return isAssigned(var) &&
+               (((value_bits[var >> 6] >> (var & 63)) & 1) == (lit > 0));
+    }
+
+    /** @brief 直接写入变量状态（赋值与回溯共用） */
+    void setVarState(int var, VarState s) {
+        uint64_t mask = 1ULL << (var & 63);
+        if (s == VAR_UNASSIGNED) {
+            assigned_bits[var >> 6] &= ~mask;
+        } else {
+            assigned_bits[var >> 6] |= mask;
+            if (s == VAR_TRUE) value_bits[var >> 6] |= mask;
+            else value_bits[var >> 6] &= ~mask;
+        }
+    }
+
+    // 回溯栈（SoA布局）：四个平行数组代替结构体数组，
+    // 每项从16字节（含填充）降到约9字节，回溯时按列连续扫描
+    std::vector<int> trail_var;                 ///< 被赋值的变量
+    std::vector<int8_t> trail_old_value;        ///< 变量的旧值（压缩为1字节）
+    std::vector<int> trail_level;               ///< 赋值时的决策层级
+    std::vector<uint64_t> trail_decision_bits;  ///< 是否为决策变量，每项1位
+
     std::vector<bool> clause_satisfied;         ///< 子句是否已满足
+
+    // 计数器式传播状态：每子句的真/假文字计数由assign/backtrack
+    // 按变量的出现列表增量维护，单子句/冲突的判定变为纯计数比较，
+    // 传播不再每轮重扫全部子句的全部文字
+    std::vector<std::vector<uint32_t>> occ_pos; ///< 变量以正文字出现的子句下标
+    std::vector<std::vector<uint32_t>> occ_neg; ///< 变量以负文字出现的子句下标
+    std::vector<uint32_t> num_true;             ///< 每子句当前为真的文字数
+    std::vector<uint32_t> num_false;            ///< 每子句当前为假的文字数
+    std::vector<uint32_t> pending;              ///< 疑似单子句/冲突的待查队列
+    int sat_clauses = 0;                        ///< 当前num_true>0的子句数
+
+    // 持久的分支活跃度：构建时按出现次数打底，冲突时对冲突子句
+    // 变量做指数加权bump（VSIDS风格），选分支不再逐子句重算计数
+    std::vector<double> score;                  ///< 每变量分支活跃度
+    double score_inc = 1.0;                     ///< 当前bump步长
+
     int num_vars;                               ///< 变量总数
     int decision_level;                         ///< 当前决策层级
+
+    /** @brief 回溯栈第i项是否为决策赋值 */
+    bool trailIsDecision(size_t i) const {
+        return (trail_decision_bits[i >> 6] >> (i & 63)) & 1;
+    }
     
     FastCNF(int vars = 0) : num_vars(vars), decision_level(0) {
-        assignment.resize(vars + 1, VAR_UNASSIGNED);
+        off.push_back(0);
+        assigned_bits.resize((vars >> 6) + 1, 0);
+        value_bits.resize((vars >> 6) + 1, 0);
     }
     
     /**
@@ -190,6 +406,14 @@ public:
      * @brief 单子句传播
      */
     bool unitPropagate();
+
+    /**
+     * @brief 根层预处理：纯文字消除至不动点，随后单子句传播
+     * @return 预处理即冲突返回false
+     * @details 只在搜索开始前调用一次；单极性赋值只会满足子句，
+     *          对一次性求解保持可满足性
+     */
+    bool preprocess();
     
     /**
      * @brief 赋值变量并记录到trail
@@ -20,6 +20,34 @@
 #include <algorithm>
 using namespace std;
 
+// ==================== 编译器提示宏 ====================
+// 分支预测与热点函数提示（GCC/Clang），其他编译器退化为空
+#if defined(__GNUC__) || defined(__clang__)
+#define LIKELY(x)   __builtin_expect(!!(x), 1)
+#define UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define HOT_FUNC    __attribute__((hot))
+#define CTZ32(x)    __builtin_ctz(x)
+#define POPCNT32(x) __builtin_popcount(x)
+#define PREFETCH_W(p) __builtin_prefetch((p), 1, 1)
+#else
+#define LIKELY(x)   (x)
+#define UNLIKELY(x) (x)
+#define HOT_FUNC
+#define PREFETCH_W(p) ((void)0)
+/** @brief 最低置位比特的下标（x不得为0），非GCC编译器的逐位退化实现 */
+inline int CTZ32(unsigned x) {
+    int n = 0;
+    while (!(x & 1u)) { x >>= 1; ++n; }
+    return n;
+}
+/** @brief 置位比特个数，非GCC编译器的逐位退化实现 */
+inline int POPCNT32(unsigned x) {
+    int n = 0;
+    while (x) { x &= x - 1; ++n; }
+    return n;
+}
+#endif
+
 // ==================== 常量定义 ====================
 #define N 9                     // 数独网格大小 9x9
 #define MAX_VAR 10000          // SAT变量最大数量，根据实际需求调整
@@ -43,4 +71,14 @@ void clearScreen();
  */
 void pauseProgram();
 
+/**
+ * @brief 建议内核对大块缓冲启用2MB透明大页
+ * @details 大公式的文字数组跨越数百个4KB页，TLB缺失开销可观；
+ *          对≥2MB的缓冲调用madvise(MADV_HUGEPAGE)请求合并为大页。
+ *          小缓冲、非Linux平台或不支持时静默退化为空操作
+ * @param p 缓冲起始地址（无需页对齐，内部向内取整）
+ * @param bytes 缓冲长度
+ */
+void adviseHugePages(const void* p, size_t bytes);
+
 #endif // COMMON_H
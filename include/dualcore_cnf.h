@@ -34,6 +34,20 @@
  */
 int DPLL_DualCore(SATList*& cnf, int value[]);
 
+/**
+ * @brief 收集根层单子句传播蕴含的单元赋值（两分支共享）
+ *
+ * 互补分裂下，分支在自己假设下推出的结论对兄弟分支无用
+ * （含该假设否定的子句在兄弟侧恒满足），真正可共享的只有
+ * 与假设无关的根层单元蕴含。在分裂前做一次不动点单子句
+ * 传播，把推出的文字同时喂给两个分支，免去各自重复推导
+ *
+ * @param cnf CNF公式链表（只读扫描，不修改）
+ * @param units 输出参数，根层蕴含的文字序列
+ * @return 根层即冲突（公式不可满足）返回0，否则返回1
+ */
+int collectRootUnits(SATList* cnf, std::vector<int>& units);
+
 /**
  * @brief 选择最优分支变量
  * 
@@ -19,14 +19,52 @@
  */
 class OptimizedCNF {
 private:
-    std::vector<std::vector<int>> clauses;      ///< 子句集合
-    std::vector<bool> assignment;               ///< 变量赋值：true为真，false为假
-    std::vector<bool> is_assigned;              ///< 变量是否已赋值：true已赋值，false未赋值
-    std::vector<bool> clause_satisfied;         ///< 子句是否已满足
+    // 子句数据在求解期间只读：以shared_ptr持有，拷贝求解器时
+    // 只共享指针。双核并行的两个分支各自复制赋值/满足状态，
+    // 但不再各深拷贝一份完整子句集。
+    // 存储复用CNFArena的扁平CSR布局（lits+off）：每子句不再是
+    // 独立堆分配的vector，传播扫描一个子句只摸连续内存，
+    // 省去每子句24字节的vector头和一次指针追逐
+    std::shared_ptr<const CNFArena> clauses;    ///< 子句集合（只读共享，扁平存储）
+
+    /** @brief 只读访问扁平子句存储 */
+    const CNFArena& arena() const { return *clauses; }
+
+    /** @brief 子句i的文字数 */
+    int clauseLen(int i) const { return (int)(arena().off[i + 1] - arena().off[i]); }
+
+    /** @brief 子句i的文字起始指针（连续存储） */
+    const int* clauseLits(int i) const { return &arena().lits[arena().off[i]]; }
+
+    // 随机访问密集的状态数组用uint8_t而不是vector<bool>：
+    // 省去位寻址的移位+掩码，顺序扫描时编译器可按字节向量化。
+    // 赋值与"是否已赋值"合并为一个三值数组：求值一个文字从
+    // 两次载入（is_assigned+assignment）缩为一次载入加一次比较
+    std::vector<uint8_t> val;                   ///< 变量状态：VAL_UNSET/VAL_FALSE/VAL_TRUE
+    std::vector<uint8_t> clause_satisfied;      ///< 子句是否已满足
     int num_vars;                               ///< 变量总数
     int num_clauses;                            ///< 子句总数
     
 public:
+    /** @brief 变量三值状态编码 */
+    enum : uint8_t { VAL_UNSET = 0, VAL_FALSE = 1, VAL_TRUE = 2 };
+
+    /** @brief 变量是否已赋值 */
+    bool isAssigned(int var) const { return val[var] != VAL_UNSET; }
+
+    /** @brief 文字在当前赋值下为真（未赋值视为否）
+     *  @details 目标值按符号算术合成（正文字2、负文字1），
+     *           不走三目分支：文字符号随数据随机，分支版在
+     *           热循环里是稳定的误预测源 */
+    bool litTrue(int lit) const {
+        return val[abs(lit)] == (uint8_t)(VAL_FALSE + (lit > 0));
+    }
+
+    /** @brief 文字在当前赋值下为假（未赋值视为否），同为无分支合成 */
+    bool litFalse(int lit) const {
+        return val[abs(lit)] == (uint8_t)(VAL_FALSE + (lit < 0));
+    }
+
     OptimizedCNF(int vars = 0, int clauses_count = 0);
     
     /**
@@ -50,8 +88,8 @@ public:
     std::vector<int> getAssignment() const { 
         std::vector<int> result(num_vars + 1, -1);
         for (int i = 1; i <= num_vars; i++) {
-            if (is_assigned[i]) {
-                result[i] = assignment[i] ? 1 : 0;
+            if (val[i] != VAL_UNSET) {
+                result[i] = (val[i] == VAL_TRUE) ? 1 : 0;
             }
         }
         return result;
@@ -62,10 +100,9 @@ public:
      */
     void setAssignment(int var, int value) { 
         if (value == -1) {
-            is_assigned[var] = false;
+            val[var] = VAL_UNSET;
         } else {
-            is_assigned[var] = true;
-            assignment[var] = (value == 1);
+            val[var] = (value == 1) ? VAL_TRUE : VAL_FALSE;
         }
     }
     
@@ -75,9 +112,15 @@ public:
     int getNumVars() const { return num_vars; }
     
     /**
-     * @brief 拷贝构造
+     * @brief 拷贝/移动构造
+     * @details 成员皆为值语义容器（子句集经shared_ptr共享），
+     *          编译器合成版本即是正确实现；显式default让移动
+     *          构造noexcept，容器扩容时走移动而非逐成员深拷贝
      */
-    OptimizedCNF(const OptimizedCNF& other);
+    OptimizedCNF(const OptimizedCNF& other) = default;
+    OptimizedCNF(OptimizedCNF&& other) noexcept = default;
+    OptimizedCNF& operator=(const OptimizedCNF& other) = default;
+    OptimizedCNF& operator=(OptimizedCNF&& other) noexcept = default;
     
     /**
      * @brief 调试函数：打印CNF状态信息
@@ -92,33 +135,63 @@ public:
  */
 class OptimizedDPLL {
 private:
-    /**
-     * @brief 赋值变更记录，用于增量回溯
-     */
-    struct AssignmentChange {
-        int var;                ///< 变更的变量
-        bool old_value;         ///< 原始值
-        bool was_assigned;      ///< 原来是否已赋值
-    };
-    
     OptimizedCNF cnf;
+    std::atomic<bool>* stop_flag;               ///< 协作取消标志（并行竞争时由胜者置位）
     std::vector<int> pos_count;                 ///< 正文字计数
     std::vector<int> neg_count;                 ///< 负文字计数
-    std::vector<AssignmentChange> undo_stack;   ///< 回溯栈
-    
-    // 预处理优化数据结构
-    std::vector<std::vector<std::pair<int, int>>> var_to_clauses; ///< 变量到子句的映射 {clause_idx, literal}
+
+    // 时间顺序回溯栈：赋值是单调的（未赋值→已赋值），
+    // 回退只需清回VAL_UNSET，每项4字节变量号即可
+    std::vector<int> trail;                     ///< 已赋值变量，按赋值顺序
+
+    // 满足标记同样按时间顺序记日志：传播落下标记时记下子句号，
+    // 回溯弹回到决策前的日志长度即可逐项撤销，
+    // 取代原来每次回溯对全部子句的清零加重扫
+    std::vector<int> sat_trail;                 ///< 被置满足标记的子句，按置位顺序
+    std::vector<uint32_t> trail_sat_mark;       ///< 每次赋值前的sat_trail长度
+
     
     // VSIDS启发式数据结构
     std::vector<double> activity;               ///< 变量活跃度
-    std::vector<int> order_heap;                ///< 按活跃度排序的变量堆
+    std::vector<uint8_t> saved_phase;           ///< 相位保存：变量最近一次被赋的极性
+    std::vector<int> order_heap;                ///< 按活跃度排序的变量大顶堆
+    std::vector<int> heap_pos;                  ///< 变量在order_heap中的下标，-1表示不在堆中
     double activity_inc;                        ///< 活跃度增量
     double decay_factor;                        ///< 衰减因子
     int decision_count;                         ///< 决策计数器
+
+    /**
+     * @brief 堆内上滤（bump后活跃度只增不减）
+     */
+    void heapSiftUp(int idx);
+
+    /**
+     * @brief 堆内下滤（弹出堆顶后恢复堆序）
+     */
+    void heapSiftDown(int idx);
+
+    /**
+     * @brief 变量入堆（回溯撤销赋值时重新入堆）
+     */
+    void heapInsert(int var);
     
     // Two-Watched Literals 数据结构
-    std::vector<std::vector<int>> watches;      ///< 每个文字对应的watched子句列表
+    /**
+     * @brief 紧凑的8字节监视项（MiniSat/KISSAT风格）
+     * @details 二元子句直接把另一个文字内联在监视项中（clause_idx为
+     *          BINARY_CLAUSE），传播时无需访问子句存储；
+     *          长子句携带阻塞文字blocker，若blocker已为真则
+     *          跳过整个子句，避免一次缓存缺失
+     */
+    struct Watcher {
+        int blocker;            ///< 阻塞文字；二元子句时为另一个文字
+        int clause_idx;         ///< 子句下标，BINARY_CLAUSE表示二元子句内联
+    };
+    static const int BINARY_CLAUSE = -1;        ///< 二元子句的clause_idx标记
+
+    std::vector<std::vector<Watcher>> watches;  ///< 每个文字对应的监视项列表
     std::vector<std::pair<int, int>> clause_watched; ///< 每个子句的两个watched文字索引
+    std::vector<int> prop_queue;                ///< 传播队列（刚变真的文字），缓冲跨调用复用
     
     /**
      * @brief 变量选择启发式（MOM + Jeroslow-Wang）
@@ -141,20 +214,15 @@ private:
     bool simplifyFormula(int literal);
     
     /**
-     * @brief 更新子句状态
+     * @brief 置子句满足标记并记入撤销日志
      */
-    void updateClauseStatus();
-    
+    void markSatisfied(int clause_idx);
+
     /**
      * @brief 计算文字出现频率
      */
     void calculateLiteralCounts();
     
-    /**
-     * @brief 构建变量到子句的映射
-     */
-    void buildVarClauseMapping();
-    
     /**
      * @brief 提升变量活跃度
      */
@@ -177,8 +245,10 @@ private:
     
     /**
      * @brief 在冲突时提升相关变量的活跃度
+     * @param lits 冲突子句的文字数组
+     * @param n 文字个数
      */
-    void handleConflict(const std::vector<int>& conflict_clause);
+    void handleConflict(const int* lits, int n);
     
     /**
      * @brief 初始化Two-Watched Literals数据结构
@@ -197,8 +267,10 @@ private:
     
     /**
      * @brief 更新某个子句的watched literal
+     * @return 0=找不到新监视文字；1=子句已满足（监视项原地保留）；
+     *         2=监视已迁移（调用方负责从旧列表丢弃监视项）
      */
-    bool updateWatch(int clause_idx, int old_watch_literal);
+    int updateWatch(int clause_idx, int old_watch_literal);
     
     /**
      * @brief 记录变量赋值变更，用于回溯
@@ -213,12 +285,24 @@ private:
     /**
      * @brief 获取当前决策层级
      */
-    size_t getCurrentLevel() const { return undo_stack.size(); }
+    size_t getCurrentLevel() const { return trail.size(); }
     
     /**
-     * @brief DPLL递归求解
+     * @brief 决策栈帧：记录决策变量、回溯点与已尝试的分支
+     * @details 首分支取保存的相位而非固定true：回溯后沿上次
+     *          一致的部分赋值继续，减少来回震荡
+     */
+    struct DPLLFrame {
+        int var;                ///< 决策变量
+        size_t trail_mark;      ///< 决策前的trail长度（回溯点）
+        bool first_phase;       ///< 首分支采用的极性（取自相位保存）
+        bool tried_second;      ///< 是否已尝试相反分支
+    };
+
+    /**
+     * @brief DPLL迭代求解（显式决策栈，避免深层递归爆栈）
      */
-    bool dpllRecursive();
+    bool dpllIterative();
     
 public:
     OptimizedDPLL(SATList* sat_cnf);
@@ -227,7 +311,23 @@ public:
      * @brief 求解SAT问题
      */
     bool solve();
-    
+
+    /**
+     * @brief 设置协作取消标志
+     * @details 并行竞争求解时，另一分支求出解后置位该标志，
+     *          本求解器在搜索循环中以relaxed load轮询并尽快退出
+     */
+    void setStopFlag(std::atomic<bool>* stop) { stop_flag = stop; }
+
+    /**
+     * @brief 设置VSIDS活跃度衰减因子
+     * @details 并行分支用不同衰减做启发式差异化（组合式并行）：
+     *          衰减小则近期冲突主导、搜索激进，衰减大则偏保守；
+     *          两个分支即使落入同构子树也会走出不同的探索顺序
+     */
+    void setDecayFactor(double decay) { decay_factor = decay; }
+
+
     /**
      * @brief 记录变量赋值并触发Two-Watched Literals传播
      */
@@ -13,6 +13,8 @@
 #include "optimize_cnf.h"
 
 // ==================== 数独相关函数 ====================
+// 网格一律用uint8_t存储（取值0~9）：整盘81字节而非324字节，
+// 回溯生成器反复扫描的棋盘只占两条缓存行
 
 // 百分号数独特殊窗口位置定义
 extern int upperWindow[9][2];
@@ -26,7 +28,7 @@ extern int lowerWindow[9][2];
  * @param num 要放置的数字（1-9）
  * @return 合法返回true，否则返回false
  */
-bool isSafe(int grid[N][N], int row, int col, int num);
+bool isSafe(uint8_t grid[N][N], int row, int col, int num);
 
 /**
  * @brief 使用回溯算法填充完整的数独网格
@@ -35,7 +37,7 @@ bool isSafe(int grid[N][N], int row, int col, int num);
  * @param col 当前填充的列号，默认从0开始
  * @return 填充成功返回true，失败返回false
  */
-bool fillGrid(int grid[N][N], int row = 0, int col = 0);
+bool fillGrid(uint8_t grid[N][N], int row = 0, int col = 0);
 
 /**
  * @brief 从完整数独中生成谜题，确保解的唯一性
@@ -43,22 +45,26 @@ bool fillGrid(int grid[N][N], int row = 0, int col = 0);
  * @param puzzle 生成的数独谜题（输出参数）
  * @param clues 要保留的提示数字个数
  */
-void generatePuzzle(int full[N][N], int puzzle[N][N], int clues);
+void generatePuzzle(uint8_t full[N][N], uint8_t puzzle[N][N], int clues);
 
 /**
  * @brief 打印数独网格到控制台
  * @param grid 要打印的数独网格
  */
-void printSudoku(int grid[N][N]);
+void printSudoku(uint8_t grid[N][N]);
 
 /**
  * @brief 将数独坐标和数字转换为SAT变量索引
  * @param row 行号（0-8）
  * @param col 列号（0-8）
  * @param num 数字（1-9）
- * @return SAT变量索引
+ * @return SAT变量索引（1~729）
+ * @details 定义为constexpr内联函数：sudokuToCNF中O(N³)次调用
+ *          全部在编译期折叠进调用循环，无函数调用开销
  */
-int varIndex(int row, int col, int num);
+constexpr int varIndex(int row, int col, int num) noexcept {
+    return row * 81 + col * 9 + num;
+}
 
 /**
  * @brief 设置数独求解的全局变量（boolCount和clauseCount）
@@ -78,7 +84,23 @@ bool saveSudokuCNF(SATList* cnf, const char* filename);
  * @param puzzle 数独谜题
  * @param cnf 输出的CNF公式（输出参数）
  */
-void sudokuToCNF(int puzzle[N][N], SATList*& cnf);
+void sudokuToCNF(uint8_t puzzle[N][N], SATList*& cnf);
+
+/**
+ * @brief 返回数独结构约束的只读CNF（扁平存储）
+ * @return 格/行/列/宫/对角线/窗口约束子句，与具体谜题无关
+ * @details 首次调用时构建一次，之后所有谜题（含DualCore各线程）
+ *          共享同一份只读数据，不再逐谜题重建上万个子句
+ */
+const CNFArena& sudokuBaseCNF();
+
+/**
+ * @brief 将数独谜题转换为扁平存储的CNF公式
+ * @param puzzle 数独谜题
+ * @param arena 输出的CNF公式（输出参数）
+ * @details 整体复制结构约束后仅追加至多81个提示单子句
+ */
+void sudokuToCNF(uint8_t puzzle[N][N], CNFArena& arena);
 
 /**
  * @brief 检查用户输入的数独解是否正确
@@ -86,7 +108,7 @@ void sudokuToCNF(int puzzle[N][N], SATList*& cnf);
  * @param ans 用户输入的答案
  * @return 正确返回true，错误返回false
  */
-bool check(int solved[9][9], int ans[9][9]);
+bool check(uint8_t solved[9][9], uint8_t ans[9][9]);
 /**
  * @brief 计算数独谜题的解的数量
  * @param puzzle 数独谜题，0表示空格
@@ -94,6 +116,6 @@ bool check(int solved[9][9], int ans[9][9]);
  * @return 解的数量（最多计算到maxSolutions个）
  * @note 该函数使用手写栈实现的搜索算法，避免了递归调用可能导致的栈溢出
  */
-int countSolutions(int puzzle[N][N], int maxSolutions = 2);
+int countSolutions(uint8_t puzzle[N][N], int maxSolutions = 2);
 
 #endif // SUDOKU_H
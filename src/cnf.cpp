@@ -1,58 +1,111 @@
 #include "cnf.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ==================== 节点池分配器实现 ====================
+
+namespace {
+
 /**
- * @brief 从CNF文件读取SAT问题实现
- * @param cnf 输出参数，存储读取的CNF公式链表
- * @return 成功返回1，失败返回0
- * @details 读取标准DIMACS CNF格式文件：
- *          - 以'c'开头的行为注释行，会被跳过
- *          - 包含"p cnf variables clauses"格式的问题行
- *          - 每个子句以0结尾
+ * @brief 定长对象slab池
+ * @details 成块批量申请内存，逐个切出对象；释放的对象通过自由链表
+ *          复用（借用对象前8字节存放链表指针）。slab从64KB起按倍数
+ *          增长到2MB封顶：小公式内存占用不变，大公式slab数量对数级，
+ *          且2MB的slab恰好够上透明大页门槛，降低节点遍历的TLB压力。
+ *          池本身进程存活期内不归还给系统，适合求解器这种
+ *          分配-释放高度重复的负载
  */
-int ReadFile(SATList*& cnf)
-{
-    // 打开指定的CNF文件
-    FILE* fp = fopen(fileName, "r");
-    if (!fp) {
-        printf("File open failed!\n");
-        return 0;
+class NodePool {
+public:
+    explicit NodePool(size_t item_size)
+        : cur_(nullptr), end_(nullptr), free_list_(nullptr),
+          item_size_(item_size < sizeof(void*) ? sizeof(void*) : item_size),
+          slab_size_(64 * 1024) {}
+
+    void* alloc() {
+        if (free_list_) {
+            void* p = free_list_;
+            free_list_ = *(void**)p;
+            return p;
+        }
+        if (cur_ + item_size_ > end_) {
+            const size_t MAX_SLAB = 2 * 1024 * 1024;
+            slabs_.emplace_back(new char[slab_size_]);
+            cur_ = slabs_.back().get();
+            end_ = cur_ + slab_size_;
+            if (slab_size_ >= MAX_SLAB) {
+                adviseHugePages(cur_, slab_size_);
+            } else {
+                slab_size_ *= 2;
+            }
+        }
+        void* p = cur_;
+        cur_ += item_size_;
+        return p;
     }
 
-    char ch;
-    // 跳过注释行，CNF文件中以'c'开头的行为注释
-    while ((ch = getc(fp)) == 'c') {
-        while ((ch = getc(fp)) != '\n');  // 读到行末
+    void release(void* p) {
+        *(void**)p = free_list_;
+        free_list_ = p;
     }
 
-    // 回退一个字符，准备读取问题行"p cnf"
-    ungetc(ch, fp);
-    char tmp[10];
-    fscanf(fp, "%s", tmp);  // 读取"p"
-    fscanf(fp, "%s", tmp);  // 读取"cnf"
+private:
+    std::vector<std::unique_ptr<char[]>> slabs_;
+    char* cur_;
+    char* end_;
+    void* free_list_;
+    size_t item_size_;
+    size_t slab_size_;
+};
+
+NodePool nodePool(sizeof(SATNode));
+NodePool listPool(sizeof(SATList));
 
-    // 读取变量数和子句数
-    fscanf(fp, "%d %d", &boolCount, &clauseCount);
+} // namespace
 
-    cnf = nullptr;                      // 初始化CNF链表头
+SATNode* allocNode() { return (SATNode*)nodePool.alloc(); }
+SATList* allocList() { return (SATList*)listPool.alloc(); }
+void freeNode(SATNode* node) { nodePool.release(node); }
+void freeList(SATList* clause) { listPool.release(clause); }
+
+/**
+ * @brief 从CNF文件读取SAT问题实现
+ * @param cnf 输出参数，存储读取的CNF公式链表
+ * @return 成功返回1，失败返回0
+ * @details 复用扁平存储的mmap+手写扫描读取路径（免去每个整数一次
+ *          的fscanf调用），再把扁平结果转为链表表示；
+ *          节点取自slab池，转换只做顺序追加
+ */
+int ReadFile(SATList*& cnf)
+{
+    CNFArena arena;
+    if (!ReadFile(arena)) return 0;
+
+    cnf = nullptr;
     SATList* prevClause = nullptr;      // 用于连接子句链表的前驱指针
 
-    // 逐个读取子句
-    for (int i = 0; i < clauseCount; i++) {
-        // 创建新的子句节点
-        SATList* clause = (SATList*)malloc(sizeof(SATList));
+    int n = arena.clauseNum();
+    for (int i = 0; i < n; i++) {
+        SATList* clause = allocList();
         clause->head = nullptr;
         clause->next = nullptr;
+        clause->prev = prevClause;
 
         SATNode* prevNode = nullptr;    // 用于连接文字链表的前驱指针
-        int number;
-
-        // 读取子句中的所有文字，直到遇到0
-        while (fscanf(fp, "%d", &number) == 1 && number != 0) {
-            // 创建文字节点
-            SATNode* node = (SATNode*)malloc(sizeof(SATNode));
-            node->data = number;
+        for (uint32_t k = arena.off[i]; k < arena.off[i + 1]; k++) {
+            SATNode* node = allocNode();
+            node->data = arena.lits[k];
             node->next = nullptr;
 
-            // 将文字节点加入子句链表
             if (!clause->head) {
                 clause->head = node;        // 第一个文字作为子句头
             }
@@ -62,7 +115,6 @@ int ReadFile(SATList*& cnf)
             prevNode = node;
         }
 
-        // 将子句加入CNF链表
         if (!cnf) {
             cnf = clause;                   // 第一个子句作为CNF头
         }
@@ -71,12 +123,315 @@ int ReadFile(SATList*& cnf)
         }
         prevClause = clause;
     }
+    return 1;
+}
 
-    printf("Reading completed\n");
-    fclose(fp);
+/**
+ * @brief 对内存中的DIMACS文本做手写整数扫描
+ * @param p 文本起始指针
+ * @param end 文本结束指针
+ * @return 成功返回1，失败返回0
+ * @details 逐字符解析：跳过注释与空白，数字按 x=x*10+c-'0' 累加，
+ *          无strtol、无locale查表，解析速度只受内存带宽限制
+ */
+static int parseDimacs(const char* p, const char* end, CNFArena& arena)
+{
+    // 整行跳注释交给memchr：libc按SIMD宽度扫描换行符，
+    // 比逐字符比较快一个数量级，长注释头的算例尤其受益
+    auto skipLine = [&p, end]() {
+        const char* nl = (const char*)memchr(p, '\n', end - p);
+        p = nl ? nl + 1 : end;
+    };
+
+    // 跳过注释行与空白，定位到问题行"p cnf V C"
+    while (p < end) {
+        if (*p == 'c') {
+            skipLine();
+        } else if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            ++p;
+        } else {
+            break;
+        }
+    }
+    if (p >= end || *p != 'p') return 0;
+
+    // 跳过"p cnf"，停在第一个数字
+    while (p < end && (*p < '0' || *p > '9')) ++p;
+
+    // 读取下一个整数（含负号），容忍子句之间插入的注释行
+    auto readInt = [&p, end, &skipLine](int& out) -> bool {
+        for (;;) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+            if (p < end && *p == 'c') { skipLine(); continue; }
+            break;
+        }
+        if (p >= end) return false;
+        bool neg = (*p == '-');
+        if (neg) ++p;
+        int x = 0;
+        bool any = false;
+        while (p < end && *p >= '0' && *p <= '9') {
+            x = x * 10 + (*p++ - '0');
+            any = true;
+        }
+        if (!any) return false;
+        out = neg ? -x : x;
+        return true;
+    };
+
+    if (!readInt(boolCount) || !readInt(clauseCount)) return 0;
+
+    arena.clear();
+    arena.lits.reserve((size_t)clauseCount * 3);  // 经验值：多数算例为3-SAT
+    arena.off.reserve((size_t)clauseCount + 1);
+
+    // 读入时按极性位图做子句内检查：重复文字直接丢弃，同时含
+    // x与-x的子句永真、整条不落盘。位图一次性分配，每条子句
+    // 结束后只清除实际触碰过的变量位，清理成本与子句长度成正比
+    std::vector<uint64_t> seen_pos((boolCount >> 6) + 1, 0);
+    std::vector<uint64_t> seen_neg((boolCount >> 6) + 1, 0);
+    std::vector<int> touched;
+
+    int number;
+    for (int i = 0; i < clauseCount; i++) {
+        arena.beginClause();
+        bool tautology = false;
+        touched.clear();
+        while (readInt(number) && number != 0) {
+            if (tautology) continue;    // 只消费剩余文字
+            int v = number > 0 ? number : -number;
+            if (UNLIKELY(v > boolCount)) {  // 超界变量不做位图检查
+                arena.pushLiteral(number);
+                continue;
+            }
+            uint64_t bit = 1ULL << (v & 63);
+            uint64_t& same = (number > 0 ? seen_pos : seen_neg)[v >> 6];
+            uint64_t opp = (number > 0 ? seen_neg : seen_pos)[v >> 6];
+            if (opp & bit) { tautology = true; continue; }
+            if (same & bit) continue;   // 重复文字
+            same |= bit;
+            touched.push_back(v);
+            arena.pushLiteral(number);
+        }
+        for (int v : touched) {
+            seen_pos[v >> 6] &= ~(1ULL << (v & 63));
+            seen_neg[v >> 6] &= ~(1ULL << (v & 63));
+        }
+        if (tautology) {
+            // 回退本子句已压入的文字，子句不产生
+            arena.lits.resize(arena.off.back());
+        } else {
+            arena.endClause();
+        }
+    }
+    // 下游一律以实际落盘的子句数为准
+    clauseCount = arena.clauseNum();
     return 1;
 }
 
+/**
+ * @brief 从CNF文件直接读入扁平存储实现
+ * @param arena 输出参数，存储读取的CNF公式
+ * @return 成功返回1，失败返回0
+ * @details POSIX平台用mmap把文件整体映射为只读内存后做单遍扫描，
+ *          免去每个整数一次的fscanf调用；Windows退回缓冲读取
+ */
+int ReadFile(CNFArena& arena)
+{
+#ifndef _WIN32
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        printf("File open failed!\n");
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        printf("File open failed!\n");
+        close(fd);
+        return 0;
+    }
+
+    // 提示内核顺序预读，降低缺页停顿
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    const char* base = (const char*)mmap(nullptr, (size_t)st.st_size,
+                                         PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+    madvise((void*)base, (size_t)st.st_size, MADV_WILLNEED);
+
+    int ok = parseDimacs(base, base + st.st_size, arena);
+
+    munmap((void*)base, (size_t)st.st_size);
+    close(fd);
+    if (ok) {
+        // 大公式的文字数组申请透明大页，降低后续全量扫描的TLB压力
+        adviseHugePages(arena.lits.data(), arena.lits.size() * sizeof(int));
+        printf("Reading completed\n");
+    }
+    return ok;
+#else
+    // Windows：整体读入缓冲区后复用同一扫描器
+    FILE* fp = fopen(fileName, "rb");
+    if (!fp) {
+        printf("File open failed!\n");
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    std::vector<char> buf(size > 0 ? (size_t)size : 1);
+    size_t got = fread(buf.data(), 1, buf.size(), fp);
+    fclose(fp);
+
+    int ok = parseDimacs(buf.data(), buf.data() + got, arena);
+    if (ok) printf("Reading completed\n");
+    return ok;
+#endif
+}
+
+/**
+ * @brief 在给定赋值下计算扁平存储中某个子句的真值实现
+ * @details 对 lits[off[i]..off[i+1]) 做连续下标循环，缓存友好；
+ *          启用AVX2编译时（-mavx2）一次gather评估8个文字
+ */
+int evaluateClause(const CNFArena& arena, int clauseIdx, int v[])
+{
+    uint32_t k = arena.off[clauseIdx];
+    const uint32_t end = arena.off[clauseIdx + 1];
+
+#if defined(__AVX2__)
+    // 8路并行：符号取自文字本身，赋值用gather一次取8个
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; k + 8 <= end; k += 8) {
+        __m256i lit = _mm256_loadu_si256((const __m256i*)&arena.lits[k]);
+        __m256i var = _mm256_abs_epi32(lit);
+        __m256i val = _mm256_i32gather_epi32(v, var, 4);
+        __m256i pos_sat = _mm256_cmpeq_epi32(val, one);    // 正文字：v[var]==1
+        __m256i neg_sat = _mm256_cmpeq_epi32(val, zero);   // 负文字：v[var]==0
+        __m256i is_neg = _mm256_cmpgt_epi32(zero, lit);
+        __m256i sat = _mm256_blendv_epi8(pos_sat, neg_sat, is_neg);
+        if (_mm256_movemask_epi8(sat) != 0) return 1;
+    }
+#endif
+
+    for (; k < end; k++) {
+        // 无分支极性判定：文字为真当且仅当v[var]等于符号位的反
+        // （正文字要求1，负文字要求0），把短路链压成一次整数比较
+        int lit = arena.lits[k];
+        if (v[abs(lit)] == (int)(lit > 0)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 检查扁平存储的CNF公式中是否包含空子句实现
+ * @details 空子句即相邻偏移相等；AVX2下一次比较8对偏移
+ */
+int emptyClause(const CNFArena& arena)
+{
+    int n = arena.clauseNum();
+    int i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 8 <= n; i += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&arena.off[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)&arena.off[i + 1]);
+        __m256i eq = _mm256_cmpeq_epi32(a, b);
+        if (_mm256_movemask_epi8(eq) != 0) return 1;
+    }
+#endif
+
+    for (; i < n; i++) {
+        if (arena.off[i] == arena.off[i + 1]) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 寻找扁平存储的CNF公式中的单子句实现
+ */
+int unitClause(const CNFArena& arena)
+{
+    int n = arena.clauseNum();
+    for (int i = 0; i < n; i++) {
+        if (arena.off[i] + 1 == arena.off[i + 1]) {
+            return arena.lits[arena.off[i]];
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 判断扁平存储中某个子句是否为单子句实现
+ */
+int isUnitClause(const CNFArena& arena, int clauseIdx)
+{
+    return arena.off[clauseIdx] + 1 == arena.off[clauseIdx + 1];
+}
+
+/**
+ * @brief 深拷贝扁平存储的CNF公式实现
+ * @details 整块复制两个vector，分配次数与公式规模无关
+ */
+void CopyClause(CNFArena& a, const CNFArena& b)
+{
+    a.lits = b.lits;
+    a.off = b.off;
+}
+
+/**
+ * @brief 从传统链表结构转换实现
+ */
+void CNFArena::fromSATList(SATList* cnf)
+{
+    clear();
+    for (SATList* lp = cnf; lp != nullptr; lp = lp->next) {
+        beginClause();
+        for (SATNode* tp = lp->head; tp != nullptr; tp = tp->next) {
+            pushLiteral(tp->data);
+        }
+        endClause();
+    }
+}
+
+/**
+ * @brief 转换回传统链表结构实现（仅供遗留调用者使用）
+ */
+SATList* CNFArena::toSATList() const
+{
+    SATList* head = nullptr;
+    SATList* prevClause = nullptr;
+    int n = clauseNum();
+    for (int i = 0; i < n; i++) {
+        SATList* clause = allocList();
+        clause->head = nullptr;
+        clause->next = nullptr;
+        clause->prev = prevClause;
+
+        SATNode* prevNode = nullptr;
+        for (uint32_t k = off[i]; k < off[i + 1]; k++) {
+            SATNode* node = allocNode();
+            node->data = lits[k];
+            node->next = nullptr;
+            if (!clause->head) clause->head = node;
+            else prevNode->next = node;
+            prevNode = node;
+        }
+
+        if (!head) head = clause;
+        else prevClause->next = clause;
+        prevClause = clause;
+    }
+    return head;
+}
+
 /**
  * @brief 销毁CNF公式链表，释放所有内存
  * @param cnf 要销毁的CNF公式链表引用
@@ -91,14 +446,14 @@ void destroyClause(SATList*& cnf)
     for (clausePtr = cnf; clausePtr != NULL; clausePtr = nextClause) {
         nextClause = clausePtr->next;
         
-        // 释放当前子句中的所有文字节点
+        // 归还当前子句中的所有文字节点
         for (literalPtr = clausePtr->head; literalPtr != NULL; literalPtr = nextLiteral) {
             nextLiteral = literalPtr->next;
-            free(literalPtr);
+            freeNode(literalPtr);
         }
         
-        // 释放子句节点
-        free(clausePtr);
+        // 归还子句节点
+        freeList(clausePtr);
     }
     
     cnf = NULL;  // 置空指针，避免悬挂指针
@@ -126,7 +481,7 @@ int isUnitClause(SATNode* cnf)
 SATNode* unitClause(SATList* cnf)
 {
     SATList* tp = cnf;
-    while (tp != nullptr) {
+    while (LIKELY(tp != nullptr)) {
         if (isUnitClause(tp->head)) {
             return tp->head;
         }
@@ -145,11 +500,11 @@ SATNode* unitClause(SATList* cnf)
 int evaluateClause(SATNode* cnf, int v[])
 {
     SATNode* tp = cnf;
-    while (tp != NULL) {
-        // 正文字：变量为真时文字为真
-        // 负文字：变量为假时文字为真
-        if ((tp->data > 0 && v[tp->data] == 1) ||
-            (tp->data < 0 && v[-tp->data] == 0)) {
+    // 循环继续是常态分支：标注后编译器把循环体排为直落路径
+    while (LIKELY(tp != NULL)) {
+        // 正文字要求v为1，负文字要求v为0：与符号位直接比较，
+        // 免去依赖文字符号的短路分支（符号不可预测时尤其划算）
+        if (v[abs(tp->data)] == (int)(tp->data > 0)) {
             return 1;  // 找到一个为真的文字，子句为真
         }
         tp = tp->next;
@@ -165,23 +520,18 @@ int evaluateClause(SATNode* cnf, int v[])
  */
 int removeClause(SATList*& cnf, SATList*& root)
 {
-    SATList* lp = root;
-    
-    if (lp == cnf) {
-        // 要删除的是头节点
-        root = root->next;
+    // 双向链接使删除无需从root扫描前驱
+    if (cnf->prev != NULL) {
+        cnf->prev->next = cnf->next;
     }
     else {
-        // 寻找要删除节点的前驱
-        while (lp != NULL && lp->next != cnf) {
-            lp = lp->next;
-        }
-        if (lp != NULL) {
-            lp->next = lp->next->next;
-        }
+        root = cnf->next;
     }
-    
-    free(cnf);
+    if (cnf->next != NULL) {
+        cnf->next->prev = cnf->prev;
+    }
+
+    freeList(cnf);
     cnf = NULL;
     return 1;
 }
@@ -194,23 +544,31 @@ int removeClause(SATList*& cnf, SATList*& root)
  */
 int removeNode(SATNode*& cnf, SATNode*& head)
 {
-    SATNode* lp = head;
-    
-    if (lp == cnf) {
-        // 要删除的是头节点
+    if (cnf == head) {
         head = head->next;
+        freeNode(cnf);
+    }
+    else if (cnf->next != NULL) {
+        // 非尾节点：把后继的内容搬进当前节点后删除后继，
+        // 免去从head扫描前驱（调用方不得跨删除持有节点指针）
+        SATNode* victim = cnf->next;
+        cnf->data = victim->data;
+        cnf->next = victim->next;
+        freeNode(victim);
+        cnf = NULL;
+        return 1;
     }
     else {
-        // 寻找要删除节点的前驱
+        // 尾节点没有后继可搬，只能扫描前驱（子句长度通常很小）
+        SATNode* lp = head;
         while (lp != NULL && lp->next != cnf) {
             lp = lp->next;
         }
         if (lp != NULL) {
-            lp->next = lp->next->next;
+            lp->next = NULL;
         }
+        freeNode(cnf);
     }
-    
-    free(cnf);
     cnf = NULL;
     return 1;
 }
@@ -226,6 +584,8 @@ int addClause(SATList* cnf, SATList*& root)
 {
     if (cnf != NULL) {
         cnf->next = root;
+        cnf->prev = NULL;
+        if (root != NULL) root->prev = cnf;
         root = cnf;
         return 1;
     }
@@ -266,7 +626,7 @@ void CopyClause(SATList*& a, SATList* b) {
 	// 使用迭代而不是递归来避免栈溢出
 	while (currentB != nullptr) {
 		// 创建新的子句节点
-		SATList* newClause = (SATList*)malloc(sizeof(SATList));
+		SATList* newClause = allocList();
 		if (newClause == nullptr) {
 			// 内存分配失败，清理已分配的内存
 			destroyClause(a);
@@ -276,13 +636,14 @@ void CopyClause(SATList*& a, SATList* b) {
 
 		newClause->head = nullptr;
 		newClause->next = nullptr;
+		newClause->prev = prevClause;
 
 		// 复制子句中的文字
 		SATNode* currentLiteral = currentB->head;
 		SATNode* prevNode = nullptr;
 
 		while (currentLiteral != nullptr) {
-			SATNode* newNode = (SATNode*)malloc(sizeof(SATNode));
+			SATNode* newNode = allocNode();
 			if (newNode == nullptr) {
 				// 内存分配失败，清理已分配的内存
 				destroyClause(newClause); // 清理当前子句
@@ -319,125 +680,684 @@ void CopyClause(SATList*& a, SATList* b) {
 }
 
 
+// ==================== 扁平化DPLL求解 ====================
+// 求解状态为SoA扁平布局（文字数组+子句偏移），搜索采用赋值制：
+// 不再逐分支复制并破坏性简化公式，而是维护变量赋值与回溯栈，
+// 单子句传播用两文字监视（2WL）完成——每个子句只监视两个非假
+// 文字，仅当监视文字被赋假时才访问该子句找替补，其余子句在传播
+// 中完全不被触碰，取代原来每次赋值后的全公式重扫
+
+namespace {
+
+/** @brief 监视项：子句下标+阻塞文字（阻塞文字为真则子句已满足）
+ *  @details 8字节紧凑布局。二元子句整体内联：clause为BINARY_WATCH
+ *           哨兵值，blocker即子句的另一个文字，传播时完全不访问
+ *           子句存储（数独编码的成对AMO约束几乎全是二元子句） */
+struct Watch {
+    uint32_t clause;
+    int blocker;
+};
+
+constexpr uint32_t BINARY_WATCH = 0xFFFFFFFFu;  ///< 二元子句内联哨兵
+
+/** @brief 基于两文字监视的DPLL求解器状态 */
+struct WatchSolver {
+    std::vector<int> lits;              ///< 所有文字的连续存储
+    std::vector<uint32_t> off;          ///< 子句偏移，长度为子句数+1
+    // 赋值表按文字下标存放：lit_val[litIdx(l)]==1当且仅当文字l为真。
+    // 文字真/假判定从"符号分支+取值比较"变成一次纯下标读取，
+    // BCP内层循环不再因文字极性产生难预测分支
+    std::vector<uint8_t> lit_val;       ///< 文字真值表，2*(num_vars+1)项
+    std::vector<int> trail;             ///< 已赋值文字，按赋值顺序
+    std::vector<size_t> trail_lim;      ///< 每个决策层级开始时的trail长度
+    size_t qhead = 0;                   ///< 传播队列头（trail下标）
+    std::vector<std::vector<Watch>> watches;  ///< 每个文字的监视列表
+
+    // 冲突分析所需的蕴含图信息（按变量索引）
+    static constexpr int NO_REASON = -1;   ///< 决策或层0单子句，无前因子句
+    static constexpr int BIN_REASON = -2;  ///< 前因为内联二元子句
+    std::vector<int> level;             ///< 变量被赋值时的决策层级
+    std::vector<int> reason;            ///< 使变量被传播的子句下标（或哨兵）
+    std::vector<int> reason_bin;        ///< BIN_REASON时二元前因的另一文字
+    int conflict_bin[2] = {0, 0};       ///< 二元子句冲突时的两个文字
+    std::vector<uint8_t> seen;          ///< 冲突分析的访问标记（复用）
+
+    // VSIDS分支启发式：参与冲突分析的变量活跃度加成，
+    // 每次冲突后增量放大（等效于所有活跃度几何衰减）
+    std::vector<double> activity;       ///< 变量活跃度
+    double var_inc = 1.0;               ///< 当前活跃度增量
+
+    int num_vars = 0;                   ///< 变量总数（增量接口可超过boolCount）
+    std::vector<int> assumptions;       ///< 本次求解的假设文字（按层压入）
+    std::vector<uint8_t> phase;         ///< 相位保存：变量上次被撤销时的取值
+
+    // 学习子句分级管理：LBD（子句文字分布的决策层级数）小者质量高。
+    // LBD<=2的子句永久保留；其余靠"自上次清理以来被用过"位
+    // 多活一轮，到期未用即删，防止长会话中监视列表无限膨胀
+    int orig_clauses = 0;               ///< 原始公式的子句数（此前的永不删除）
+    std::vector<uint8_t> clause_lbd;    ///< 各子句的LBD（原始子句为0，255封顶）
+    std::vector<uint8_t> clause_used;   ///< 自上次清理以来传播/冲突用过
+    std::vector<uint8_t> clause_dead;   ///< 已删除标记（监视项已摘除）
+    std::vector<int> lbd_stamp;         ///< LBD计算的层级去重印章
+    int lbd_stamp_counter = 0;          ///< 当前印章值
+
+    /** @brief 当前决策层级 */
+    int currentLevel() const { return (int)trail_lim.size(); }
+
+    /** @brief 文字到监视表下标：2*var+符号位 */
+    static size_t litIdx(int literal) {
+        return ((size_t)abs(literal) << 1) | (literal < 0);
+    }
+
+    bool litTrue(int literal) const { return lit_val[litIdx(literal)] != 0; }
+
+    bool litFalse(int literal) const { return lit_val[litIdx(literal) ^ 1] != 0; }
+
+    /** @brief 变量是否未赋值（两个极性的真值位均为0） */
+    bool varFree(int var) const {
+        return (lit_val[(size_t)var << 1] | lit_val[((size_t)var << 1) | 1]) == 0;
+    }
+
+    /** @brief 赋值使文字为真并入传播队列，记录层级与前因 */
+    void assign(int literal, int reason_clause) {
+        int var = abs(literal);
+        lit_val[litIdx(literal)] = 1;
+        level[var] = currentLevel();
+        reason[var] = reason_clause;
+        trail.push_back(literal);
+    }
+
+    /** @brief 回跳到指定决策层级，撤销其后的全部赋值 */
+    void backtrack(int target_level) {
+        size_t mark = trail_lim[target_level];
+        while (trail.size() > mark) {
+            int literal = trail.back();
+            phase[abs(literal)] = (uint8_t)(literal > 0);  // 相位保存，供下次分支复用
+            lit_val[litIdx(literal)] = 0;
+            trail.pop_back();
+        }
+        trail_lim.resize(target_level);
+        qhead = mark;
+    }
+
+    /**
+     * @brief 构建：读入子句并为每个长子句登记两个监视文字
+     * @param eliminate_pure 是否在根层固定纯文字变量。一次性求解
+     *        安全且能直接砍掉公式；增量求解必须关闭——后续
+     *        incrementalAddClause可能引入相反极性，破坏纯性前提
+     * @return 初始单子句即冲突时返回false
+     */
+    bool build(SATList* cnf, bool eliminate_pure = false) {
+        for (SATList* lp = cnf; lp != nullptr; lp = lp->next) {
+            off.push_back((uint32_t)lits.size());
+            for (SATNode* tp = lp->head; tp != nullptr; tp = tp->next) {
+                lits.push_back(tp->data);
+            }
+        }
+        off.push_back((uint32_t)lits.size());
+
+        num_vars = boolCount;
+        lit_val.assign(2 * (size_t)(num_vars + 1), 0);
+        phase.assign(num_vars + 1, 1);
+        activity.assign(num_vars + 1, 0.0);
+        level.assign(num_vars + 1, 0);
+        reason.assign(num_vars + 1, NO_REASON);
+        reason_bin.assign(num_vars + 1, 0);
+        seen.assign(num_vars + 1, 0);
+        watches.assign(2 * (size_t)(num_vars + 1), {});
+
+        int n = (int)off.size() - 1;
+
+        // 预数每个文字将挂多少监视项并精确reserve：初始登记阶段
+        // 不再有任何监视列表的增长搬移，容量也不会超配
+        {
+            std::vector<uint32_t> watch_count(watches.size(), 0);
+            for (int i = 0; i < n; i++) {
+                if (off[i + 1] - off[i] < 2) continue;
+                watch_count[litIdx(lits[off[i]])]++;
+                watch_count[litIdx(lits[off[i] + 1])]++;
+            }
+            for (size_t w = 0; w < watches.size(); w++) {
+                if (watch_count[w]) watches[w].reserve(watch_count[w]);
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            uint32_t len = off[i + 1] - off[i];
+            if (len == 0) return false;             // 空子句
+            if (len == 1) {
+                int u = lits[off[i]];
+                if (litFalse(u)) return false;      // 单子句互相矛盾
+                if (!litTrue(u)) assign(u, NO_REASON);
+                continue;
+            }
+            if (len == 2) {
+                // 二元子句内联进双方监视列表，不再经过子句存储
+                watches[litIdx(lits[off[i]])].push_back({BINARY_WATCH, lits[off[i] + 1]});
+                watches[litIdx(lits[off[i] + 1])].push_back({BINARY_WATCH, lits[off[i]]});
+                continue;
+            }
+            // 约定：子句的两个监视文字始终在区间前两个位置
+            watches[litIdx(lits[off[i]])].push_back({(uint32_t)i, lits[off[i] + 1]});
+            watches[litIdx(lits[off[i] + 1])].push_back({(uint32_t)i, lits[off[i]]});
+        }
+
+        orig_clauses = n;
+        clause_lbd.assign(n, 0);
+        clause_used.assign(n, 0);
+        clause_dead.assign(n, 0);
+        lbd_stamp.assign(num_vars + 2, 0);
+
+        if (eliminate_pure) {
+            // 纯文字消除：单遍统计每个变量两种极性的出现，单极性
+            // 变量按其出现极性在根层固定，后续传播顺带化简公式。
+            // 对全部子句统计是保守的（已满足子句也计入），只会少判
+            // 不会错判纯性
+            std::vector<uint8_t> has_pos(num_vars + 1, 0), has_neg(num_vars + 1, 0);
+            for (size_t k = 0; k < lits.size(); k++) {
+                int l = lits[k];
+                if (l > 0) has_pos[l] = 1;
+                else has_neg[-l] = 1;
+            }
+            for (int v = 1; v <= num_vars; v++) {
+                if (!varFree(v)) continue;
+                if (has_pos[v] && !has_neg[v]) assign(v, NO_REASON);
+                else if (!has_pos[v] && has_neg[v]) assign(-v, NO_REASON);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 传播队列中的全部赋值
+     * @return 遇到长子句冲突返回子句下标，二元子句冲突返回
+     *         BIN_REASON（两文字存入conflict_bin），无冲突返回-1
+     * @details 对被赋假文字l只走watches[l]：阻塞文字为真直接跳过；
+     *          二元子句直接在监视项内判定满足/传播/冲突；长子句
+     *          找非假替补文字交换到监视位并迁移监视项，找不到时
+     *          另一监视文字要么传播为单子句要么冲突
+     */
+    HOT_FUNC int propagate() {
+        while (qhead < trail.size()) {
+            int false_lit = -trail[qhead++];
+            auto& ws = watches[litIdx(false_lit)];
+
+            size_t i = 0, j = 0;
+            int conflict = -1;
+            for (; i < ws.size(); i++) {
+                Watch w = ws[i];
+                // 阻塞文字为真：子句已满足，监视项原地保留
+                if (LIKELY(litTrue(w.blocker))) {
+                    ws[j++] = w;
+                    continue;
+                }
+
+                if (w.clause == BINARY_WATCH) {
+                    // 二元子句：另一文字为假即冲突，未赋值即传播
+                    ws[j++] = w;
+                    if (litFalse(w.blocker)) {
+                        conflict_bin[0] = false_lit;
+                        conflict_bin[1] = w.blocker;
+                        conflict = BIN_REASON;
+                        i++;
+                        break;
+                    }
+                    reason_bin[abs(w.blocker)] = false_lit;
+                    assign(w.blocker, BIN_REASON);
+                    continue;
+                }
+
+                uint32_t c = w.clause;
+                uint32_t p0 = off[c];
+                // 把被赋假的监视文字换到第二位，第一位为另一监视文字
+                if (lits[p0] == false_lit) {
+                    std::swap(lits[p0], lits[p0 + 1]);
+                }
+                int first = lits[p0];
+                if (first != w.blocker && litTrue(first)) {
+                    ws[j++] = {c, first};
+                    continue;
+                }
+
+                // 在剩余文字中找非假替补
+                bool moved = false;
+                for (uint32_t k = p0 + 2; k < off[c + 1]; k++) {
+                    if (!litFalse(lits[k])) {
+                        std::swap(lits[p0 + 1], lits[k]);
+                        watches[litIdx(lits[p0 + 1])].push_back({c, first});
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved) continue;                // 监视项迁走，不保留
+
+                // 无替补：另一监视文字为假则冲突，否则单子句传播
+                ws[j++] = w;
+                clause_used[c] = 1;
+                if (litFalse(first)) {
+                    conflict = (int)c;
+                    i++;
+                    break;
+                }
+                assign(first, (int)c);
+            }
+            // 压缩监视列表（含冲突时未处理的尾部）
+            while (i < ws.size()) ws[j++] = ws[i++];
+            ws.resize(j);
+
+            if (UNLIKELY(conflict != -1)) return conflict;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief 1-UIP冲突分析
+     * @param confl 冲突子句下标，或BIN_REASON（冲突在conflict_bin）
+     * @param out_blevel 输出参数，回跳目标层级
+     * @return 学习子句，首文字为断言文字（1-UIP的否定），
+     *         若长度大于1则第二个文字位于回跳层级
+     * @details 沿trail逆序对蕴含图做消解：当前层级只剩一个标记
+     *          变量（第一UIP）时停止；低层级文字进入学习子句。
+     *          内联二元子句的前因由reason_bin还原
+     */
+    std::vector<int> analyze(int confl, int& out_blevel) {
+        std::vector<int> learnt;
+        learnt.push_back(0);                    // 占位，结束后填断言文字
+
+        int path_count = 0;
+        int p = 0;
+        size_t idx = trail.size();
+        int bin_pair[2];
+
+        do {
+            // 取当前消解子句的文字区间（内联二元前因临时展开）
+            const int* cb;
+            const int* ce;
+            if (confl == BIN_REASON) {
+                bin_pair[0] = p == 0 ? conflict_bin[0] : p;
+                bin_pair[1] = p == 0 ? conflict_bin[1] : reason_bin[abs(p)];
+                cb = bin_pair;
+                ce = bin_pair + 2;
+            } else {
+                cb = &lits[off[confl]];
+                ce = &lits[off[confl + 1]];
+            }
+
+            for (; cb < ce; cb++) {
+                int q = *cb;
+                int var = abs(q);
+                if (var == abs(p) || seen[var] || level[var] == 0) continue;
+                seen[var] = 1;
+                bumpActivity(var);
+                if (level[var] >= currentLevel()) path_count++;
+                else learnt.push_back(q);
+            }
+            // 沿trail回退到下一个被标记的变量
+            while (!seen[abs(trail[--idx])]) {}
+            p = trail[idx];
+            seen[abs(p)] = 0;
+            confl = reason[abs(p)];
+            path_count--;
+        } while (path_count > 0);
+        learnt[0] = -p;
+
+        // 回跳层级 = 学习子句中除断言文字外的最高层级；
+        // 把该层级的文字换到第二位作监视文字
+        out_blevel = 0;
+        size_t second = 1;
+        for (size_t i = 1; i < learnt.size(); i++) {
+            seen[abs(learnt[i])] = 0;
+            if (level[abs(learnt[i])] > out_blevel) {
+                out_blevel = level[abs(learnt[i])];
+                second = i;
+            }
+        }
+        if (learnt.size() > 1) std::swap(learnt[1], learnt[second]);
+        return learnt;
+    }
+
+    /** @brief 学习子句的LBD：其文字分布的不同决策层级数
+     *  @details 回跳后调用：断言文字即将在回跳层级赋值，而该层级
+     *           已由第二个文字计入，故只统计learnt[1..] */
+    int computeLBD(const std::vector<int>& learnt) {
+        ++lbd_stamp_counter;
+        int lbd = 0;
+        for (size_t k = 1; k < learnt.size(); k++) {
+            int l = level[abs(learnt[k])];
+            if (lbd_stamp[l] != lbd_stamp_counter) {
+                lbd_stamp[l] = lbd_stamp_counter;
+                lbd++;
+            }
+        }
+        return lbd;
+    }
+
+    /**
+     * @brief 把学习子句追加进公式存储并登记监视
+     * @return 新子句下标，二元学习子句内联后返回BIN_REASON
+     */
+    int addLearntClause(const std::vector<int>& learnt) {
+        if (learnt.size() == 2) {
+            // 二元学习子句同样内联，不进入子句存储（LBD必然<=2，本就永久保留）
+            watches[litIdx(learnt[0])].push_back({BINARY_WATCH, learnt[1]});
+            watches[litIdx(learnt[1])].push_back({BINARY_WATCH, learnt[0]});
+            return BIN_REASON;
+        }
+        int c = (int)off.size() - 1;
+        for (int literal : learnt) lits.push_back(literal);
+        off.push_back((uint32_t)lits.size());
+        uint32_t p0 = off[c];
+        watches[litIdx(lits[p0])].push_back({(uint32_t)c, lits[p0 + 1]});
+        watches[litIdx(lits[p0 + 1])].push_back({(uint32_t)c, lits[p0]});
+
+        int lbd = computeLBD(learnt);
+        clause_lbd.push_back((uint8_t)(lbd > 255 ? 255 : lbd));
+        clause_used.push_back(1);
+        clause_dead.push_back(0);
+        return c;
+    }
+
+    /** @brief 从文字的监视列表中摘除指向子句c的监视项 */
+    void detachWatch(int literal, uint32_t c) {
+        auto& ws = watches[litIdx(literal)];
+        for (size_t k = 0; k < ws.size(); k++) {
+            if (ws[k].clause == c) {
+                ws[k] = ws.back();
+                ws.pop_back();
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief 学习子句库清理
+     * @details LBD<=2或正作为当前赋值前因（锁定）的子句保留；
+     *          其余子句凭"自上次清理被用过"位多活一轮，否则摘除
+     *          监视项并打死亡标记。存储不搬移（监视项下标保持有效），
+     *          BCP代价由监视列表长度决定，与死子句占用无关
+     */
+    void reduceDB() {
+        int n = (int)off.size() - 1;
+        for (int c = orig_clauses; c < n; c++) {
+            if (clause_dead[c]) continue;
+            if (clause_lbd[c] <= 2) continue;
+
+            int first_var = abs(lits[off[c]]);
+            bool locked = !varFree(first_var) && reason[first_var] == c;
+            if (locked) continue;
+
+            if (clause_used[c]) {
+                clause_used[c] = 0;     // 多活一轮，下轮仍未用即删
+                continue;
+            }
+            clause_dead[c] = 1;
+            detachWatch(lits[off[c]], (uint32_t)c);
+            detachWatch(lits[off[c] + 1], (uint32_t)c);
+        }
+    }
+
+    /** @brief 提升变量活跃度，溢出时整体缩放 */
+    void bumpActivity(int var) {
+        activity[var] += var_inc;
+        if (activity[var] > 1e100) {
+            for (int v = 1; v <= num_vars; v++) activity[v] *= 1e-100;
+            var_inc *= 1e-100;
+        }
+    }
+
+    /** @brief 冲突后放大增量，等效所有活跃度按0.95衰减 */
+    void decayActivity() { var_inc *= (1.0 / 0.95); }
+
+    /** @brief Luby重启序列第i项（1,1,2,1,1,2,4,...，i从1计） */
+    static int64_t luby(int64_t i) {
+        int64_t k = 1;
+        while ((1LL << k) - 1 < i) k++;
+        while ((1LL << k) - 1 != i) {
+            i -= (1LL << (k - 1)) - 1;
+            k = 1;
+            while ((1LL << k) - 1 < i) k++;
+        }
+        return 1LL << (k - 1);
+    }
+
+    /**
+     * @brief VSIDS分支选择：活跃度最高的未赋值变量
+     * @return 分支文字（正相优先），全部变量已赋值返回0
+     * @details 传播无冲突且无未赋值变量时所有子句必然满足
+     *          （否则存在全假子句，传播时即已报告冲突），
+     *          因此返回0等价于公式已满足。不再需要每次决策
+     *          对全公式做文字频率统计
+     */
+    int pickBranchLiteral() const {
+        int best_var = 0;
+        double best_act = -1.0;
+        for (int v = 1; v <= num_vars; v++) {
+            if (varFree(v) && activity[v] > best_act) {
+                best_act = activity[v];
+                best_var = v;
+            }
+        }
+        return best_var;
+    }
+
+    /** @brief 撤销全部决策与假设，回到层0（保留学习子句与层0事实） */
+    void cancelUntilRoot() {
+        if (!trail_lim.empty()) backtrack(0);
+    }
+
+    /** @brief 为增量接口扩容到指定变量数（新变量初始未赋值） */
+    void ensureVar(int var) {
+        if (var <= num_vars) return;
+        num_vars = var;
+        lit_val.resize(2 * (size_t)(num_vars + 1), 0);
+        phase.resize(num_vars + 1, 1);
+        activity.resize(num_vars + 1, 0.0);
+        level.resize(num_vars + 1, 0);
+        reason.resize(num_vars + 1, NO_REASON);
+        reason_bin.resize(num_vars + 1, 0);
+        seen.resize(num_vars + 1, 0);
+        watches.resize(2 * (size_t)(num_vars + 1));
+        lbd_stamp.resize(num_vars + 2, 0);
+    }
+
+    /**
+     * @brief 层0追加子句（增量接口）
+     * @return 子句导致层0矛盾返回false
+     * @details 必须在cancelUntilRoot之后调用。层0为假的文字被直接
+     *          删去（层0赋值永不撤销，化简合法），已满足的子句丢弃
+     */
+    bool addClauseRoot(const int* literals, int count) {
+        std::vector<int> c;
+        for (int k = 0; k < count; k++) {
+            if (litTrue(literals[k])) return true;  // 层0已满足
+            if (!litFalse(literals[k])) c.push_back(literals[k]);
+        }
+        if (c.empty()) return false;                // 层0矛盾
+        if (c.size() == 1) {
+            assign(c[0], NO_REASON);                // 下次传播时入队处理
+            return true;
+        }
+        if (c.size() == 2) {
+            watches[litIdx(c[0])].push_back({BINARY_WATCH, c[1]});
+            watches[litIdx(c[1])].push_back({BINARY_WATCH, c[0]});
+            return true;
+        }
+        int idx = (int)off.size() - 1;
+        for (int literal : c) lits.push_back(literal);
+        off.push_back((uint32_t)lits.size());
+        uint32_t p0 = off[idx];
+        watches[litIdx(lits[p0])].push_back({(uint32_t)idx, lits[p0 + 1]});
+        watches[litIdx(lits[p0 + 1])].push_back({(uint32_t)idx, lits[p0]});
+        clause_lbd.push_back(0);        // 外部追加的子句与原始子句同级，不删
+        clause_used.push_back(1);
+        clause_dead.push_back(0);
+        return true;
+    }
+
+    /**
+     * @brief 主搜索循环（CDCL）
+     * @details 冲突时做1-UIP分析得到学习子句，非时间顺序回跳到
+     *          断言层级并立即传播断言文字；学习子句进入公式存储
+     *          与监视表，阻止搜索重访等价的失败子空间。
+     *          层0冲突即整体不可满足。冲突数达到Luby序列给出的
+     *          阈值时重启：抛弃当前决策序列回到层0重搜，学习子句
+     *          与活跃度保留，用于摆脱早期坏决策锁死的子空间
+     */
+    bool search() {
+        const int64_t restart_base = 100;   // Luby序列的冲突数单位
+        const int64_t reduce_interval = 2000;   // 子句库清理周期（冲突数）
+        int64_t restart_num = 1;
+        int64_t restart_limit = restart_base * luby(restart_num);
+        int64_t conflicts = 0;
+        int64_t conflicts_since_reduce = 0;
+
+        for (;;) {
+            int confl = propagate();
+            if (confl != -1) {
+                if (currentLevel() == 0) return false;
+
+                int blevel = 0;
+                std::vector<int> learnt = analyze(confl, blevel);
+                decayActivity();
+                backtrack(blevel);
+                if (learnt.size() == 1) {
+                    assign(learnt[0], NO_REASON);   // 层0单元事实
+                } else {
+                    int c = addLearntClause(learnt);
+                    if (c == BIN_REASON) reason_bin[abs(learnt[0])] = learnt[1];
+                    assign(learnt[0], c);           // 断言文字由学习子句蕴含
+                }
+
+                if (++conflicts_since_reduce >= reduce_interval) {
+                    reduceDB();
+                    conflicts_since_reduce = 0;
+                }
+                if (++conflicts >= restart_limit && currentLevel() > 0) {
+                    restart_limit = restart_base * luby(++restart_num);
+                    conflicts = 0;
+                    backtrack(0);                   // 重启：假设由决策循环重新压入
+                }
+                continue;
+            }
+
+            // 先按层压入假设文字，再走正常的VSIDS分支
+            int branch = 0;
+            while (currentLevel() < (int)assumptions.size()) {
+                int a = assumptions[currentLevel()];
+                if (litTrue(a)) {
+                    trail_lim.push_back(trail.size());  // 已为真，占位层
+                    continue;
+                }
+                if (litFalse(a)) return false;      // 假设在当前子句库下不可满足
+                branch = a;
+                break;
+            }
+            if (branch == 0) {
+                int var = pickBranchLiteral();
+                if (var == 0) return true;          // 全部子句满足
+                branch = phase[var] ? var : -var;   // 按保存的相位取极性
+            }
+            trail_lim.push_back(trail.size());
+            assign(branch, NO_REASON);
+        }
+    }
+};
+
+} // namespace
+
 /**
  * @brief DPLL算法求解SAT问题
- * @param cnf CNF公式链表（会被修改）
+ * @param cnf CNF公式链表（只读，转换为扁平状态后求解）
  * @param value 变量赋值数组（输出参数）
  * @return 有解返回1，无解返回0
- * @details 实现经典的DPLL算法：
- *          1. 单子句传播
- *          2. 纯文字消除
- *          3. 选择变量分支
- *          使用启发式选择出现频率最高的变量进行分支
+ * @details 单子句传播基于两文字监视；冲突时做1-UIP学习并
+ *          非时间顺序回跳（CDCL），分支按VSIDS活跃度
+ *          选择变量
  */
 int DPLL(SATList*& cnf, int value[])
 {
-    SATList* tp = cnf, * lp = cnf, * sp;
-    SATNode* dp;
-    int* count;
-    int i, MaxWord = 0, max = 0, re;
-
-FIND_UNIT:
-    // 单子句传播：查找并处理单子句
-    while (tp != nullptr && !isUnitClause(tp->head))
-        tp = tp->next;
-
-    if (tp != nullptr) {
-        // 应用单子句规则进行简化
-        re = tp->head->data;
-        if (re > 0) value[re] = 1;      // 正文字赋值为真
-        else value[-re] = 0;            // 负文字对应变量赋值为假
-
-		for (lp = cnf; lp != nullptr; lp = sp) {
-			sp = lp->next;
-			for (dp = lp->head; dp != nullptr; dp = dp->next) {
-				if (dp->data == re) {
-					removeClause(lp, cnf);
-					break;
-				}
-				if (dp->data == -re) {
-					removeNode(dp, lp->head);
-					break;
-				}
-			}
-		}
-
-		// 检查极简化后结果
-		if (cnf == nullptr) return 1;
-		if (emptyClause(cnf)) {
-			destroyClause(cnf);
-			return 0;
-		}
-		tp = cnf;
-		goto FIND_UNIT;  // 继续单子句简化
-	}
+    WatchSolver s;
+    if (!s.build(cnf, /*eliminate_pure=*/true) || !s.search()) return 0;
 
-	// 分配并初始化 count 数组
-	count = (int*)malloc(sizeof(int) * (2 * boolCount + 2));
-	for (i = 0; i <= 2 * boolCount + 1; i++) count[i] = 0;
-
-	// 统计文字出现次数
-	for (lp = cnf; lp != nullptr; lp = lp->next) {
-		for (dp = lp->head; dp != nullptr; dp = dp->next) {
-			if (dp->data > 0) {
-				if (dp->data <= boolCount) {
-					count[dp->data]++;
-				}
-			}
-			else {
-				int index = boolCount - dp->data; // dp->data < 0
-				if (index <= 2 * boolCount + 1) {
-					count[index]++;
-				}
-			}
-		}
-	}
+    for (int i = 1; i <= boolCount; i++) {
+        if (s.litTrue(i)) value[i] = 1;
+        else if (s.litFalse(i)) value[i] = 0;
+    }
+    return 1;
+}
 
-	// 找出现次数最多的正文字
-	max = 0; MaxWord = 0;
-	for (i = 1; i <= boolCount; i++) {
-		if (count[i] > max) {
-			max = count[i];
-			MaxWord = i;
-		}
-	}
 
-	// 如果没有正文字出现，找出现次数最多的负文字
-	if (max == 0) {
-		for (i = 1; i <= boolCount; i++) {
-			if (count[boolCount + i] > max) {
-				max = count[boolCount + i];
-				MaxWord = -i;
-			}
-		}
-	}
+// ==================== 增量求解接口 ====================
+// 同一求解器实例跨多次solve保留学习子句、监视结构与VSIDS活跃度；
+// 每次求解的临时条件以假设文字传入，作为伪决策压在trail底部，
+// 求解结束全部撤销，不污染子句库。generatePuzzle的逐洞唯一性
+// 检查用它把上万条结构子句的建库成本摊到全部尝试上
 
-	free(count); // 安全释放
+struct IncrementalSolver {
+    WatchSolver s;      ///< 求解器状态，跨solve调用持久
+    bool ok = true;     ///< 层0已矛盾时为false，后续求解直接返回无解
+};
 
-	// 构造尝试赋值正文字分支
-	SATList* branch1 = (SATList*)malloc(sizeof(SATList));
-	branch1->head = (SATNode*)malloc(sizeof(SATNode));
-	branch1->head->data = MaxWord;
-	branch1->head->next = nullptr;
-	branch1->next = nullptr;
+/**
+ * @brief 创建增量求解器并载入初始公式
+ * @return 求解器句柄，初始公式层0即矛盾时ok已置false
+ */
+IncrementalSolver* incrementalCreate(SATList* cnf) {
+    IncrementalSolver* solver = new IncrementalSolver();
+    if (!solver->s.build(cnf)) solver->ok = false;
+    return solver;
+}
 
-	CopyClause(tp, cnf);
-	addClause(branch1, tp);
+/**
+ * @brief 分配一个新变量（用于激活文字等）
+ * @return 新变量编号
+ */
+int incrementalNewVar(IncrementalSolver* solver) {
+    solver->s.ensureVar(solver->s.num_vars + 1);
+    return solver->s.num_vars;
+}
 
-	if (DPLL(tp, value) == 1) return 1;
-	destroyClause(tp);
+/**
+ * @brief 层0追加子句
+ * @return 成功返回1，子句使公式层0矛盾返回0
+ */
+int incrementalAddClause(IncrementalSolver* solver, const int literals[], int count) {
+    if (!solver->ok) return 0;
+    solver->s.cancelUntilRoot();
+    if (!solver->s.addClauseRoot(literals, count)) {
+        solver->ok = false;
+        return 0;
+    }
+    return 1;
+}
 
-	// 构造尝试赋值负文字分支
-	SATList* branch2 = (SATList*)malloc(sizeof(SATList));
-	branch2->head = (SATNode*)malloc(sizeof(SATNode));
-	branch2->head->data = -MaxWord;
-	branch2->head->next = nullptr;
-	branch2->next = nullptr;
+/**
+ * @brief 在给定假设下求解
+ * @param assumptions 假设文字数组（可为空）
+ * @param value 变量赋值数组（输出参数，仅有解时写入）
+ * @return 有解返回1，在当前假设下无解返回0
+ */
+int incrementalSolve(IncrementalSolver* solver, const int assumptions[], int count, int value[]) {
+    if (!solver->ok) return 0;
+    solver->s.cancelUntilRoot();
+    solver->s.assumptions.assign(assumptions, assumptions + count);
+    bool sat = solver->s.search();
+    solver->s.assumptions.clear();
+    if (!sat) {
+        solver->s.cancelUntilRoot();
+        return 0;
+    }
+    for (int i = 1; i <= solver->s.num_vars; i++) {
+        if (solver->s.litTrue(i)) value[i] = 1;
+        else if (solver->s.litFalse(i)) value[i] = 0;
+    }
+    solver->s.cancelUntilRoot();
+    return 1;
+}
 
-	addClause(branch2, cnf);
-	re = DPLL(cnf, value);
-	destroyClause(cnf);
-	return re;
+/** @brief 释放增量求解器 */
+void incrementalDestroy(IncrementalSolver* solver) {
+    delete solver;
 }
 
 
@@ -449,34 +1369,41 @@ FIND_UNIT:
 */
 int WriteFile(int result, double time, int value[])
 {
-	FILE* fp;
-	int i;
-	for (i = 0; fileName[i] != '\0'; i++)
-	{
-		//修改拓展名
-		if (fileName[i] == '.' && fileName[i + 4] == '\0')
-		{
-			fileName[i + 1] = 'r';
-			fileName[i + 2] = 'e';
-			fileName[i + 3] = 's';
-			break;
-        }
-    }
+    // 把拓展名替换为.res：按最后一个'.'截断，不再假定拓展名恰为
+    // 3个字符（旧实现对.dimacs/.txt等长度不等的拓展名会静默失效）
+    std::string outName(fileName);
+    size_t dot = outName.rfind('.');
+    if (dot != std::string::npos) outName.resize(dot);
+    outName += ".res";
+    snprintf(fileName, sizeof(fileName), "%s", outName.c_str());
+
+    FILE* fp;
     if ((fp = fopen(fileName, "w")) == NULL) {
         printf("File open failed!\n");
         return 0;
     }
-	fprintf(fp, "s %d\nv ", result);  //求解结果
-	if (result == 1)
-	{
-		//保存解值
-		for (i = 1; i <= boolCount; i++)
-		{
-			if (value[i] == 1) fprintf(fp, "%d ", i);
-			else fprintf(fp, "%d ", -i);
+
+    // 解值先在内存中拼好一次性写出：逐变量fprintf要过格式解析
+    // 与流锁，大变量数时是这里的主要开销
+    std::string out;
+    out.reserve((size_t)boolCount * 8 + 64);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "s %d\nv ", result);
+    out += buf;
+    if (result == 1)
+    {
+        //保存解值
+        for (int i = 1; i <= boolCount; i++)
+        {
+            auto r = std::to_chars(buf, buf + sizeof(buf), value[i] == 1 ? i : -i);
+            out.append(buf, r.ptr);
+            out.push_back(' ');
         }
     }
-    fprintf(fp, "\nt %lf", time * 1000);  //运行时间/毫秒
+    snprintf(buf, sizeof(buf), "\nt %lf", time * 1000);  //运行时间/毫秒
+    out += buf;
+
+    fwrite(out.data(), 1, out.size(), fp);
     fclose(fp);
     return 1;
 }
\ No newline at end of file
@@ -8,6 +8,16 @@
 
 #include "../include/common.h"
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 // ==================== 全局变量定义 ====================
 int boolCount = 0;              ///< CNF公式中的布尔变量数量
 int clauseCount = 0;            ///< CNF公式中的子句数量
@@ -23,16 +33,47 @@ void clearScreen() {
 #ifdef _WIN32
     system("cls");
 #else
-    system("clear");  // Unix/Linux/macOS
+    // ANSI转义清屏并把光标归位：原来的system("clear")每次都要
+    // fork/exec一个子进程，几十毫秒的代价只为向终端发这几个
+    // 字节；直接写转义序列只是一次write
+    cout << "\x1b[2J\x1b[H" << flush;  // Unix/Linux/macOS
 #endif
 }
 
 /**
  * @brief 暂停程序等待用户输入
- * @details 跨平台的暂停函数
+ * @details 跨平台的暂停函数；stdin非终端（脚本灌入菜单指令跑
+ *          基准）时直接返回，不消费输入流里的后续指令字节
  */
 void pauseProgram() {
+#ifdef _WIN32
+    if (!_isatty(_fileno(stdin))) return;
+#else
+    if (!isatty(fileno(stdin))) return;
+#endif
     std::cout << "按回车键继续...";
     std::cin.ignore();
     std::cin.get();
 }
+
+/**
+ * @brief 建议内核对大块缓冲启用2MB透明大页
+ * @details 地址区间向内对齐到页边界后madvise；调用失败无碍正确性，
+ *          忽略返回值即可
+ */
+void adviseHugePages(const void* p, size_t bytes) {
+#if defined(__linux__)
+    const size_t kHugePage = 2u * 1024 * 1024;
+    if (p == nullptr || bytes < kHugePage) return;  // 不足一个大页，不值得
+
+    const size_t kPage = 4096;
+    uintptr_t begin = ((uintptr_t)p + kPage - 1) & ~(kPage - 1);
+    uintptr_t end = ((uintptr_t)p + bytes) & ~(kPage - 1);
+    if (end > begin) {
+        madvise((void*)begin, end - begin, MADV_HUGEPAGE);
+    }
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
@@ -8,13 +8,36 @@
 
 #include "dualcore_cnf.h"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 // ==================== 全局函数实现 ====================
 
 int DPLL_DualCore(SATList*& cnf, int value[]) {
     if (cnf == nullptr) return 0;
-    
+
+    // 根层单元蕴含只算一次，两个分支共享（见collectRootUnits注释）
+    std::vector<int> root_units;
+    if (!collectRootUnits(cnf, root_units)) {
+        return 0;  // 根层传播即冲突，无需并行搜索
+    }
+
+    std::vector<bool> unit_fixed(boolCount + 1, false);
+    for (int lit : root_units) {
+        unit_fixed[abs(lit)] = true;
+    }
+
     // 选择第一个未赋值变量（简单快速）
     int split_var = selectBestSplitVariable(cnf);
+    // 已被根层单元固定的变量不适合做分裂点（一侧必然立即冲突）
+    if (split_var != -1 && unit_fixed[split_var]) {
+        split_var = -1;
+        for (int i = 1; i <= boolCount; i++) {
+            if (!unit_fixed[i]) { split_var = i; break; }
+        }
+    }
     
     if (split_var == -1) {
         // 所有变量已赋值，直接检查
@@ -27,27 +50,56 @@ int DPLL_DualCore(SATList*& cnf, int value[]) {
     std::future<std::vector<int>> future_true = promise_true.get_future();
     std::future<std::vector<int>> future_false = promise_false.get_future();
     
-    std::atomic<bool> solution_found{false};
-    
+    // 两个原子变量各占一条缓存行：stop被两个工作线程在搜索循环中
+    // 高频轮询，若与solution_found（胜者写入）同行，写入会使对方
+    // 核心的轮询行失效，造成跨核缓存行乒乓
+    alignas(64) std::atomic<bool> solution_found{false};
+    alignas(64) std::atomic<bool> stop{false};
+
     // 分支1: var = true
+    // 把共享的根层单元赋值灌入求解器，再压入本分支的分裂假设
+    auto applyRootUnits = [&root_units](OptimizedDPLL& solver) {
+        for (int lit : root_units) {
+            if (!solver.pushAssignmentWithPropagation(abs(lit), lit > 0)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // 原型求解器只构建一次（链表转换、监视表、VSIDS堆各做一遍），
+    // 两个分支线程各拷贝一份：只读的子句集经shared_ptr共享，
+    // 真正复制的只有赋值/满足状态与监视列表
+    OptimizedDPLL proto(cnf);
+    proto.setStopFlag(&stop);
+
     std::thread thread_true([&](std::promise<std::vector<int>>&& prom) {
         if (!solution_found.load()) {
-            OptimizedDPLL solver(cnf);
-            if (solver.pushAssignmentWithPropagation(split_var, true) && 
+            OptimizedDPLL solver(proto);
+            // 组合式差异化：两分支用不同VSIDS衰减，避免在同构
+            // 子树里重复同一条探索路径（分裂本身不保证负载均衡）
+            solver.setDecayFactor(0.95);
+            if (applyRootUnits(solver) &&
+                solver.pushAssignmentWithPropagation(split_var, true) &&
                 solver.solve() && !solution_found.exchange(true)) {
+                // 胜者置位stop，败者在搜索循环中轮询到后立即退出
+                stop.store(true, std::memory_order_release);
                 prom.set_value(solver.getSolution());
             } else {
                 prom.set_value({});
             }
         }
     }, std::move(promise_true));
-    
+
     // 分支2: var = false
     std::thread thread_false([&](std::promise<std::vector<int>>&& prom) {
         if (!solution_found.load()) {
-            OptimizedDPLL solver(cnf);
-            if (solver.pushAssignmentWithPropagation(split_var, false) && 
+            OptimizedDPLL solver(proto);
+            solver.setDecayFactor(0.85);  // 更激进的近期冲突权重
+            if (applyRootUnits(solver) &&
+                solver.pushAssignmentWithPropagation(split_var, false) &&
                 solver.solve() && !solution_found.exchange(true)) {
+                stop.store(true, std::memory_order_release);
                 prom.set_value(solver.getSolution());
             } else {
                 prom.set_value({});
@@ -55,103 +107,128 @@ int DPLL_DualCore(SATList*& cnf, int value[]) {
         }
     }, std::move(promise_false));
     
-    // 等待第一个完成的结果
-    std::vector<int> result;
-    if (future_true.wait_for(std::chrono::milliseconds(5000)) == std::future_status::ready) {
-        result = future_true.get();
-        if (!result.empty()) {
-            thread_false.detach();  // 直接分离，让其自行结束
-            thread_true.join();
-            // 复制结果
-            for (int i = 1; i <= boolCount && i < (int)result.size(); ++i) {
-                value[i] = result[i];
-            }
-            return 1;
+#if defined(__linux__)
+    // 把两个分支线程钉到不同CPU：否则调度器可能把它们排到同一
+    // 物理核的SMT兄弟线程上，缓存与执行端口互相挤占，并行近乎
+    // 失效。常见枚举下0号与2号跨物理核；核数不足时退到1号。
+    // 亲和性设置失败（容器限核等）无害，忽略返回值
+    auto pinThread = [](std::thread& t, int cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+    };
+    unsigned hw = std::thread::hardware_concurrency();
+    if (hw >= 2) {
+        pinThread(thread_true, 0);
+        pinThread(thread_false, hw >= 4 ? 2 : 1);
+    }
+#endif
+
+    // 胜者已置stop促使败者在搜索循环中尽快退出，这里直接等
+    // 双方收尾后取非空结果：不再用超时截断（原来的固定等待窗
+    // 会把超窗的可满足实例误判为无解），也不再detach线程
+    thread_true.join();
+    thread_false.join();
+
+    std::vector<int> result = future_true.get();
+    if (result.empty()) result = future_false.get();
+    if (!result.empty()) {
+        for (int i = 1; i <= boolCount && i < (int)result.size(); ++i) {
+            value[i] = result[i];
         }
+        return 1;
     }
-    
-    if (future_false.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready) {
-        result = future_false.get();
-        if (!result.empty()) {
-            thread_true.detach();
-            thread_false.join();
-            // 复制结果
-            for (int i = 1; i <= boolCount && i < (int)result.size(); ++i) {
-                value[i] = result[i];
+    return 0;
+}
+
+int collectRootUnits(SATList* cnf, std::vector<int>& units) {
+    units.clear();
+    if (cnf == nullptr) return 1;
+
+    // 不动点扫描：在临时赋值表上反复找"恰剩一个未赋值文字且
+    // 尚未满足"的子句，推出其蕴含文字，直到再无新蕴含。
+    // 只读扫描原公式，不做链表删除，开销为若干遍顺序遍历
+    std::vector<int> tmp_value(boolCount + 1, -1);  // -1未赋值
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (SATList* lp = cnf; lp != nullptr; lp = lp->next) {
+            bool satisfied = false;
+            int unassigned_lit = 0;
+            int unassigned_cnt = 0;
+            for (SATNode* tp = lp->head; tp != nullptr; tp = tp->next) {
+                int var = abs(tp->data);
+                if (tmp_value[var] == -1) {
+                    unassigned_lit = tp->data;
+                    if (++unassigned_cnt > 1) break;
+                } else if ((tp->data > 0) == (tmp_value[var] == 1)) {
+                    satisfied = true;
+                    break;
+                }
+            }
+            if (satisfied) continue;
+            if (unassigned_cnt == 0) return 0;  // 根层冲突
+            if (unassigned_cnt == 1) {
+                tmp_value[abs(unassigned_lit)] = unassigned_lit > 0 ? 1 : 0;
+                units.push_back(unassigned_lit);
+                changed = true;
             }
-            return 1;
         }
     }
-    
-    // 等待所有线程完成
-    thread_true.join();
-    thread_false.join();
-    
-    return 0;
+    return 1;
 }
 
 int selectBestSplitVariable(SATList* cnf) {
     if (cnf == nullptr) return -1;
-    
-    // 统计每个变量在多少个子句中出现
-    std::vector<int> pos_count(boolCount + 1, 0);  // 正文字出现次数
-    std::vector<int> neg_count(boolCount + 1, 0);  // 负文字出现次数
-    std::vector<bool> assigned(boolCount + 1, false);  // 是否已赋值
-    
-    SATList* lp;
-    SATNode* tp;
-    
-    // 统计变量出现频率
-    for (lp = cnf; lp != nullptr; lp = lp->next) {
-        for (tp = lp->head; tp != nullptr; tp = tp->next) {
+
+    // 分裂点选择在solve之前串行执行，不值得为它全量扫描公式：
+    // 只采样前SAMPLE_CLAUSES个子句做Jeroslow-Wang打分
+    // （score[v] += 2^-|子句长度|，短子句权重高），采样信号
+    // 已足够挑出一个好的分裂变量，扫描量与公式规模解耦
+    const int SAMPLE_CLAUSES = 1024;
+
+    std::vector<double> score(boolCount + 1, 0.0);
+
+    int sampled = 0;
+    for (SATList* lp = cnf; lp != nullptr && sampled < SAMPLE_CLAUSES;
+         lp = lp->next, ++sampled) {
+        int len = 0;
+        for (SATNode* tp = lp->head; tp != nullptr; tp = tp->next) len++;
+        if (len == 0 || len > 62) continue;
+
+        double weight = 1.0 / (double)(1ULL << len);
+        for (SATNode* tp = lp->head; tp != nullptr; tp = tp->next) {
             int var = abs(tp->data);
-            if (var <= boolCount) {
-                if (tp->data > 0) {
-                    pos_count[var]++;
-                } else {
-                    neg_count[var]++;
-                }
-            }
+            if (var <= boolCount) score[var] += weight;
         }
     }
-    
-    // 选择平衡性最好的变量（正负出现次数都较多且接近）
+
     int best_var = -1;
-    double best_score = -1.0;
-    
+    double best_score = 0.0;
     for (int i = 1; i <= boolCount; i++) {
-        if (!assigned[i] && (pos_count[i] > 0 || neg_count[i] > 0)) {
-            // 计算平衡分数：考虑总出现次数和正负平衡
-            int total = pos_count[i] + neg_count[i];
-            double balance = 1.0 - abs(pos_count[i] - neg_count[i]) / (double)total;
-            double score = total * balance;
-            
-            if (score > best_score) {
-                best_score = score;
-                best_var = i;
-            }
+        if (score[i] > best_score) {
+            best_score = score[i];
+            best_var = i;
         }
     }
-    
     return best_var;
 }
 
 double estimateBranchComplexity(SATList* cnf, int var, bool assignment) {
     if (cnf == nullptr) return 0.0;
-    
-    int remaining_clauses = 0;
-    int total_literals = 0;
-    
-    SATList* lp;
-    SATNode* tp;
-    
-    for (lp = cnf; lp != nullptr; lp = lp->next) {
+
+    // 原式"剩余子句数*(总文字数/剩余子句数)"代数上就等于剩余
+    // 总文字数，除法纯属浪费；直接用整数累加返回同一指标
+    int64_t total_literals = 0;
+
+    for (SATList* lp = cnf; lp != nullptr; lp = lp->next) {
         bool clause_satisfied = false;
         int clause_literals = 0;
-        
-        for (tp = lp->head; tp != nullptr; tp = tp->next) {
+
+        for (SATNode* tp = lp->head; tp != nullptr; tp = tp->next) {
             clause_literals++;
-            
+
             // 检查当前赋值是否满足这个文字
             if (abs(tp->data) == var) {
                 if ((tp->data > 0 && assignment) || (tp->data < 0 && !assignment)) {
@@ -160,13 +237,11 @@ double estimateBranchComplexity(SATList* cnf, int var, bool assignment) {
                 }
             }
         }
-        
+
         if (!clause_satisfied) {
-            remaining_clauses++;
             total_literals += clause_literals;
         }
     }
-    
-    // 复杂度估算：剩余子句数 * 平均文字数
-    return remaining_clauses * (total_literals / (double)std::max(1, remaining_clauses));
+
+    return (double)total_literals;
 }
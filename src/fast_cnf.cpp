@@ -0,0 +1,344 @@
+/**
+ * @file fast_cnf.cpp
+ * @brief 高效CNF公式表示（FastCNF）及高效DPLL算法实现
+ * @author [Hus-King]
+ * @date 2025-09-04
+ * @version 1.0
+ */
+
+#include "cnf.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ==================== FastCNF类实现 ====================
+
+void FastCNF::fromSATList(SATList* cnf) {
+    // 先数一遍总文字数，一次reserve后顺序追加，避免增长时反复搬移
+    size_t total_lits = 0;
+    size_t total_clauses = 0;
+    for (SATList* clause_ptr = cnf; clause_ptr != nullptr; clause_ptr = clause_ptr->next) {
+        total_clauses++;
+        for (SATNode* literal_ptr = clause_ptr->head; literal_ptr != nullptr; literal_ptr = literal_ptr->next) {
+            total_lits++;
+        }
+    }
+
+    lits.clear();
+    lits.reserve(total_lits);
+    off.clear();
+    off.reserve(total_clauses + 1);
+    off.push_back(0);
+    for (SATList* clause_ptr = cnf; clause_ptr != nullptr; clause_ptr = clause_ptr->next) {
+        for (SATNode* literal_ptr = clause_ptr->head; literal_ptr != nullptr; literal_ptr = literal_ptr->next) {
+            lits.push_back(literal_ptr->data);
+        }
+        off.push_back((uint32_t)lits.size());
+    }
+
+    adviseHugePages(lits.data(), lits.size() * sizeof(int));
+
+    num_vars = boolCount;
+    assigned_bits.assign((num_vars >> 6) + 1, 0);
+    value_bits.assign((num_vars >> 6) + 1, 0);
+    clause_satisfied.assign(clauseNum(), false);
+    trail_var.clear();
+    trail_old_value.clear();
+    trail_level.clear();
+    trail_decision_bits.clear();
+    decision_level = 0;
+
+    // 建立变量出现列表并清零子句计数；长度<=1的子句预先入队：
+    // 空子句即冲突，单子句等传播首轮推出。出现列表先数后填，
+    // 逐列表精确reserve，填充阶段零增长搬移零容量超配
+    occ_pos.assign(num_vars + 1, {});
+    occ_neg.assign(num_vars + 1, {});
+    {
+        std::vector<uint32_t> pos_cnt(num_vars + 1, 0), neg_cnt(num_vars + 1, 0);
+        for (int literal : lits) {
+            if (literal > 0) pos_cnt[literal]++;
+            else neg_cnt[-literal]++;
+        }
+        for (int v = 1; v <= num_vars; v++) {
+            if (pos_cnt[v]) occ_pos[v].reserve(pos_cnt[v]);
+            if (neg_cnt[v]) occ_neg[v].reserve(neg_cnt[v]);
+        }
+    }
+    num_true.assign(clauseNum(), 0);
+    num_false.assign(clauseNum(), 0);
+    sat_clauses = 0;
+    pending.clear();
+    for (int i = 0; i < clauseNum(); ++i) {
+        for (uint32_t k = off[i]; k < off[i + 1]; ++k) {
+            int literal = lits[k];
+            if (literal > 0) occ_pos[literal].push_back((uint32_t)i);
+            else occ_neg[-literal].push_back((uint32_t)i);
+        }
+        if (off[i + 1] - off[i] <= 1) pending.push_back((uint32_t)i);
+    }
+
+    // 分支活跃度按出现次数打底（与旧的逐子句计数同口径），
+    // 之后只在冲突处增量bump，选分支时不再重算
+    score.assign(num_vars + 1, 0.0);
+    for (int v = 1; v <= num_vars; v++) {
+        score[v] = (double)(occ_pos[v].size() + occ_neg[v].size());
+    }
+    score_inc = 1.0;
+}
+
+SATList* FastCNF::toSATList() const {
+    SATList* head = nullptr;
+    SATList* prevClause = nullptr;
+
+    for (int i = 0; i < clauseNum(); ++i) {
+        SATList* newClause = allocList();
+        newClause->head = nullptr;
+        newClause->next = nullptr;
+        newClause->prev = prevClause;
+
+        SATNode* prevNode = nullptr;
+        for (uint32_t k = off[i]; k < off[i + 1]; ++k) {
+            SATNode* node = allocNode();
+            node->data = lits[k];
+            node->next = nullptr;
+            if (!newClause->head) newClause->head = node;
+            else prevNode->next = node;
+            prevNode = node;
+        }
+
+        if (!head) head = newClause;
+        else prevClause->next = newClause;
+        prevClause = newClause;
+    }
+    return head;
+}
+
+FastCNF FastCNF::copy() const {
+    return *this;
+}
+
+bool FastCNF::hasEmptyClause() const {
+    // 计数判定：假文字数等于子句长度即空子句，无需访问文字
+    for (int i = 0; i < clauseNum(); ++i) {
+        if (num_false[i] == off[i + 1] - off[i]) return true;
+    }
+    return false;
+}
+
+bool FastCNF::allClausesSatisfied() const {
+    // 满足子句数由assign/backtrack在计数0/1翻转时增量维护，
+    // 此处退化为一次整数比较，不再按节点做O(子句数)的扫描
+    return sat_clauses == clauseNum();
+}
+
+HOT_FUNC bool FastCNF::unitPropagate() {
+    // 计数器式传播：assign把"无真文字且假文字数达到长度-1"的
+    // 子句压入pending，此处逐个核对后推出其唯一未赋值文字；
+    // 回溯后的过期条目靠重新核对过滤，不再每轮重扫全部子句
+    while (!pending.empty()) {
+        uint32_t c = pending.back();
+        pending.pop_back();
+        uint32_t len = off[c + 1] - off[c];
+        if (num_true[c] > 0) continue;                    // 已满足
+        if (UNLIKELY(num_false[c] == len)) {
+            // 空子句，冲突：bump冲突子句中的变量。步长指数增长
+            // 等价于对历史得分做指数衰减（VSIDS），超界时整体缩放
+            for (uint32_t k = off[c]; k < off[c + 1]; ++k) {
+                score[abs(lits[k])] += score_inc;
+            }
+            score_inc /= 0.95;
+            if (UNLIKELY(score_inc > 1e100)) {
+                for (double& s : score) s *= 1e-100;
+                score_inc *= 1e-100;
+            }
+            return false;
+        }
+        if (num_false[c] != len - 1) continue;            // 过期条目
+        for (uint32_t k = off[c]; k < off[c + 1]; ++k) {
+            int literal = lits[k];
+            if (!isAssigned(abs(literal))) {
+                assign(abs(literal), literal > 0 ? VAR_TRUE : VAR_FALSE, false);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool FastCNF::preprocess() {
+    // 纯文字消除：只统计未满足子句中未赋值变量的极性，单极性
+    // 变量按该极性直接赋值（只会满足子句，不会证伪任何文字）；
+    // 赋值使更多子句满足后可能产生新的纯文字，循环至不动点。
+    // 仅用于搜索前的根层——搜索内部的化简交给计数器传播
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        std::vector<uint8_t> has_pos(num_vars + 1, 0), has_neg(num_vars + 1, 0);
+        for (int i = 0; i < clauseNum(); ++i) {
+            if (num_true[i] > 0) continue;
+            for (uint32_t k = off[i]; k < off[i + 1]; ++k) {
+                int literal = lits[k];
+                int var = abs(literal);
+                if (isAssigned(var)) continue;
+                if (literal > 0) has_pos[var] = 1;
+                else has_neg[var] = 1;
+            }
+        }
+        for (int v = 1; v <= num_vars; v++) {
+            if (isAssigned(v) || has_pos[v] == has_neg[v]) continue;
+            assign(v, has_pos[v] ? VAR_TRUE : VAR_FALSE, false);
+            changed = true;
+        }
+        if (!unitPropagate()) return false;
+    }
+    return true;
+}
+
+void FastCNF::assign(int var, VarState value, bool is_decision) {
+    size_t idx = trail_var.size();
+    trail_var.push_back(var);
+    trail_old_value.push_back((int8_t)varValue(var));
+    trail_level.push_back(decision_level);
+
+    if ((idx >> 6) >= trail_decision_bits.size()) {
+        trail_decision_bits.push_back(0);
+    }
+    if (is_decision) {
+        trail_decision_bits[idx >> 6] |= 1ULL << (idx & 63);
+    } else {
+        trail_decision_bits[idx >> 6] &= ~(1ULL << (idx & 63));
+    }
+
+    setVarState(var, value);
+
+    // 增量维护子句计数：满足侧只加计数；证伪侧在假文字数
+    // 逼近子句长度时把子句压入待查队列。
+    // 子句下标在出现列表中无规律，计数数组按下标随机访问；
+    // 提前若干项发预取，用当前项的计算时间遮掩下一批的访存延迟
+    const size_t PF_DIST = 8;
+    const auto& sat_occ = (value == VAR_TRUE) ? occ_pos[var] : occ_neg[var];
+    const auto& fal_occ = (value == VAR_TRUE) ? occ_neg[var] : occ_pos[var];
+    for (size_t j = 0; j < sat_occ.size(); ++j) {
+        if (j + PF_DIST < sat_occ.size()) PREFETCH_W(&num_true[sat_occ[j + PF_DIST]]);
+        uint32_t c = sat_occ[j];
+        if (num_true[c]++ == 0) sat_clauses++;
+    }
+    for (size_t j = 0; j < fal_occ.size(); ++j) {
+        if (j + PF_DIST < fal_occ.size()) PREFETCH_W(&num_false[fal_occ[j + PF_DIST]]);
+        uint32_t c = fal_occ[j];
+        num_false[c]++;
+        if (num_true[c] == 0 && num_false[c] + 1 >= off[c + 1] - off[c]) {
+            pending.push_back(c);
+        }
+    }
+}
+
+void FastCNF::backtrack(int level) {
+    // 从栈顶向下弹出所有层级大于level的赋值；
+    // SoA布局下trail_level是连续int数组，该扫描可被编译器向量化
+    size_t i = trail_var.size();
+    while (i > 0 && trail_level[i - 1] > level) {
+        --i;
+        int var = trail_var[i];
+
+        // 先按当前取值回退子句计数，再撤销赋值；
+        // 与assign同理，对随机下标的计数访问做提前预取
+        const size_t PF_DIST = 8;
+        bool was_true = (value_bits[var >> 6] >> (var & 63)) & 1;
+        const auto& sat_occ = was_true ? occ_pos[var] : occ_neg[var];
+        const auto& fal_occ = was_true ? occ_neg[var] : occ_pos[var];
+        for (size_t j = 0; j < sat_occ.size(); ++j) {
+            if (j + PF_DIST < sat_occ.size()) PREFETCH_W(&num_true[sat_occ[j + PF_DIST]]);
+            if (--num_true[sat_occ[j]] == 0) sat_clauses--;
+        }
+        for (size_t j = 0; j < fal_occ.size(); ++j) {
+            if (j + PF_DIST < fal_occ.size()) PREFETCH_W(&num_false[fal_occ[j + PF_DIST]]);
+            num_false[fal_occ[j]]--;
+        }
+
+        setVarState(var, (VarState)trail_old_value[i]);
+    }
+    trail_var.resize(i);
+    trail_old_value.resize(i);
+    trail_level.resize(i);
+    decision_level = level;
+
+    // 队列中的条目基于回退前的计数，整体作废（重新核对也能过滤，
+    // 清空避免跨分支累积）
+    pending.clear();
+}
+
+int FastCNF::chooseBranchVariable() const {
+    // 在持久活跃度上取未赋值变量的argmax：得分由fromSATList打底、
+    // unitPropagate在冲突处bump，本函数不再逐子句重算计数
+    int best_var = 0;
+    double best_score = -1.0;
+    int v = 1;
+
+#if defined(__AVX2__)
+    // 4路并行求最大值：按块比较，块内出现更大值才回落标量确认
+    // （确认时检查赋值状态），argmax的索引携带留在标量侧
+    __m256d vmax = _mm256_set1_pd(-1.0);
+    for (; v + 4 <= num_vars + 1; v += 4) {
+        __m256d s = _mm256_loadu_pd(&score[v]);
+        __m256d gt = _mm256_cmp_pd(s, vmax, _CMP_GT_OQ);
+        if (_mm256_movemask_pd(gt) != 0) {
+            for (int j = 0; j < 4; j++) {
+                if (score[v + j] > best_score && !isAssigned(v + j)) {
+                    best_score = score[v + j];
+                    best_var = v + j;
+                }
+            }
+            vmax = _mm256_set1_pd(best_score);
+        }
+    }
+#endif
+
+    for (; v <= num_vars; v++) {
+        if (!isAssigned(v) && score[v] > best_score) {
+            best_score = score[v];
+            best_var = v;
+        }
+    }
+    return best_var;
+}
+
+// ==================== 高效DPLL算法实现 ====================
+
+/**
+ * @brief 高效单线程DPLL算法实现
+ * @details 基于回溯栈撤销赋值，避免每个分支深拷贝整个公式
+ */
+bool FastDPLL_SingleThread(FastCNF& cnf) {
+    if (!cnf.unitPropagate()) return false;
+    if (cnf.allClausesSatisfied()) return true;
+
+    int var = cnf.chooseBranchVariable();
+    if (var == 0) return cnf.allClausesSatisfied();
+
+    int level = cnf.decision_level;
+
+    // 分支1：var = true
+    cnf.decision_level = level + 1;
+    cnf.assign(var, VAR_TRUE, true);
+    if (FastDPLL_SingleThread(cnf)) return true;
+    cnf.backtrack(level);
+
+    // 分支2：var = false
+    cnf.decision_level = level + 1;
+    cnf.assign(var, VAR_FALSE, true);
+    if (FastDPLL_SingleThread(cnf)) return true;
+    cnf.backtrack(level);
+
+    return false;
+}
+
+/**
+ * @brief 高效DPLL算法主入口
+ * @details 先做根层预处理（纯文字消除+传播），再进入递归搜索
+ */
+bool FastDPLL(FastCNF& cnf) {
+    if (!cnf.preprocess()) return false;
+    return FastDPLL_SingleThread(cnf);
+}
@@ -12,55 +12,57 @@
 
 // ==================== OptimizedCNF类实现 ====================
 
-OptimizedCNF::OptimizedCNF(int vars, int clauses_count) 
-    : num_vars(vars), num_clauses(clauses_count) {
-    assignment.resize(vars + 1, false);      // 使用vector<bool>存储
-    is_assigned.resize(vars + 1, false);     // 跟踪是否已赋值
-    clause_satisfied.resize(clauses_count, false);
-}
-
-OptimizedCNF::OptimizedCNF(const OptimizedCNF& other) {
-    clauses = other.clauses;
-    assignment = other.assignment;
-    is_assigned = other.is_assigned;
-    clause_satisfied = other.clause_satisfied;
-    num_vars = other.num_vars;
-    num_clauses = other.num_clauses;
+OptimizedCNF::OptimizedCNF(int vars, int clauses_count)
+    : clauses(std::make_shared<const CNFArena>()),
+      num_vars(vars), num_clauses(clauses_count) {
+    val.resize(vars + 1, VAL_UNSET);         // 每变量1字节三值状态，随机访问无位运算开销
+    clause_satisfied.resize(clauses_count, 0);
 }
 
 void OptimizedCNF::fromSATList(SATList* cnf) {
-    clauses.clear();
+    // 先在本地构建扁平存储再整体冻结为只读共享数据；
+    // 空子句照旧跳过（与历史行为一致）
+    CNFArena built;
     num_clauses = 0;
-    
+
+    // 预扫一遍统计规模后精确reserve：链表节点本就要全部走到，
+    // 多走一遍换来lits/off零重分配（几何扩容在大公式上要搬动
+    // 多次半成品数组）
+    size_t total_clauses = 0, total_literals = 0;
     for (SATList* clause_ptr = cnf; clause_ptr != nullptr; clause_ptr = clause_ptr->next) {
-        std::vector<int> clause;
+        if (clause_ptr->head == nullptr) continue;
+        total_clauses++;
         for (SATNode* literal_ptr = clause_ptr->head; literal_ptr != nullptr; literal_ptr = literal_ptr->next) {
-            clause.push_back(literal_ptr->data);
+            total_literals++;
         }
-        if (!clause.empty()) {
-            clauses.push_back(clause);
-            num_clauses++;
+    }
+    built.lits.reserve(total_literals);
+    built.off.reserve(total_clauses + 1);
+
+    for (SATList* clause_ptr = cnf; clause_ptr != nullptr; clause_ptr = clause_ptr->next) {
+        if (clause_ptr->head == nullptr) continue;
+        built.beginClause();
+        for (SATNode* literal_ptr = clause_ptr->head; literal_ptr != nullptr; literal_ptr = literal_ptr->next) {
+            built.pushLiteral(literal_ptr->data);
         }
+        built.endClause();
+        num_clauses++;
     }
-    
-    clause_satisfied.resize(num_clauses, false);
+
+    clauses = std::make_shared<const CNFArena>(std::move(built));
+    clause_satisfied.resize(num_clauses, 0);
 }
 
 bool OptimizedCNF::hasEmptyClause() const {
-    for (size_t i = 0; i < clauses.size(); ++i) {
+    for (int i = 0; i < num_clauses; ++i) {
         if (clause_satisfied[i]) continue;
-        
+
         bool all_false = true;
-        for (int literal : clauses[i]) {
-            int var = abs(literal);
-            
-            if (!is_assigned[var]) {  // 未赋值
-                all_false = false;
-                break;
-            }
-            
-            bool lit_true = (literal > 0) ? assignment[var] : !assignment[var];
-            if (lit_true) {
+        const int* lp = clauseLits(i);
+        const int len = clauseLen(i);
+        for (int k = 0; k < len; ++k) {
+            // 未被证伪（未赋值或为真）即非空子句，一次载入一次比较
+            if (!litFalse(lp[k])) {
                 all_false = false;
                 break;
             }
@@ -71,28 +73,24 @@ bool OptimizedCNF::hasEmptyClause() const {
 }
 
 bool OptimizedCNF::allClausesSatisfied() const {
-    for (size_t i = 0; i < clauses.size(); ++i) {
+    for (int i = 0; i < num_clauses; ++i) {
         if (clause_satisfied[i]) continue;
-        
+
+        const int* lp = clauseLits(i);
+        const int len = clauseLen(i);
         bool satisfied = false;
-        for (int literal : clauses[i]) {
-            int var = abs(literal);
-            
-            if (is_assigned[var]) {  // 已赋值
-                bool lit_true = (literal > 0) ? assignment[var] : !assignment[var];
-                if (lit_true) {
-                    satisfied = true;
-                    break;
-                }
+        for (int k = 0; k < len; ++k) {
+            if (litTrue(lp[k])) {
+                satisfied = true;
+                break;
             }
         }
-        
+
         if (!satisfied) {
             // 检查是否是单子句且未满足
             int unassigned_count = 0;
-            for (int literal : clauses[i]) {
-                int var = abs(literal);
-                if (!is_assigned[var]) {
+            for (int k = 0; k < len; ++k) {
+                if (!isAssigned(abs(lp[k]))) {
                     unassigned_count++;
                 }
             }
@@ -109,18 +107,19 @@ void OptimizedCNF::printDebugInfo() const {
     std::cout << "=== CNF Debug Info ===" << std::endl;
     std::cout << "Variables: " << num_vars << ", Clauses: " << num_clauses << std::endl;
     
-    for (size_t i = 0; i < clauses.size(); ++i) {
-        std::cout << "Clause " << i << " (satisfied=" << clause_satisfied[i] << "): ";
-        for (int lit : clauses[i]) {
-            std::cout << lit << " ";
+    for (int i = 0; i < num_clauses; ++i) {
+        std::cout << "Clause " << i << " (satisfied=" << (int)clause_satisfied[i] << "): ";
+        const int* lp = clauseLits(i);
+        for (int k = 0; k < clauseLen(i); ++k) {
+            std::cout << lp[k] << " ";
         }
         std::cout << std::endl;
     }
     
     std::cout << "Assignments: ";
-    for (size_t i = 1; i < assignment.size(); ++i) {
-        if (is_assigned[i]) {
-            std::cout << "x" << i << "=" << (assignment[i] ? 1 : 0) << " ";
+    for (size_t i = 1; i < val.size(); ++i) {
+        if (val[i] != VAL_UNSET) {
+            std::cout << "x" << i << "=" << (val[i] == VAL_TRUE ? 1 : 0) << " ";
         } else {
             std::cout << "x" << i << "=-1 ";
         }
@@ -130,8 +129,9 @@ void OptimizedCNF::printDebugInfo() const {
 
 // ==================== OptimizedDPLL类实现 ====================
 
-OptimizedDPLL::OptimizedDPLL(SATList* sat_cnf) 
-    : cnf(boolCount, clauseCount), activity_inc(1.0), decay_factor(0.95), decision_count(0) {
+OptimizedDPLL::OptimizedDPLL(SATList* sat_cnf)
+    : cnf(boolCount, clauseCount), stop_flag(nullptr),
+      activity_inc(1.0), decay_factor(0.95), decision_count(0) {
     cnf.fromSATList(sat_cnf);
     pos_count.resize(boolCount + 1, 0);
     neg_count.resize(boolCount + 1, 0);
@@ -139,9 +139,19 @@ OptimizedDPLL::OptimizedDPLL(SATList* sat_cnf)
     // 初始化VSIDS相关数据结构
     activity.resize(boolCount + 1, 0.0);
     order_heap.reserve(boolCount);
-    
-    // 构建变量到子句的映射
-    buildVarClauseMapping();
+    heap_pos.assign(boolCount + 1, -1);
+    for (int v = 1; v <= boolCount; v++) {
+        heapInsert(v);
+    }
+
+    // 相位保存：初始相位按文字符号多数（Jeroslow-Wang风格的
+    // 极性先验），之后每次赋值覆盖为实际极性
+    calculateLiteralCounts();
+    saved_phase.resize(boolCount + 1, 1);
+    for (int v = 1; v <= boolCount; v++) {
+        saved_phase[v] = pos_count[v] >= neg_count[v] ? 1 : 0;
+    }
+
     
     // 初始化Two-Watched Literals
     initWatchedLiterals();
@@ -151,12 +161,15 @@ void OptimizedDPLL::calculateLiteralCounts() {
     std::fill(pos_count.begin(), pos_count.end(), 0);
     std::fill(neg_count.begin(), neg_count.end(), 0);
     
-    for (size_t i = 0; i < cnf.clauses.size(); ++i) {
+    for (int i = 0; i < cnf.num_clauses; ++i) {
         if (cnf.clause_satisfied[i]) continue;
-        
-        for (int literal : cnf.clauses[i]) {
+
+        const int* lp = cnf.clauseLits(i);
+        const int len = cnf.clauseLen(i);
+        for (int k = 0; k < len; ++k) {
+            int literal = lp[k];
             int var = abs(literal);
-            if (var <= cnf.num_vars && !cnf.is_assigned[var]) {
+            if (var <= cnf.num_vars && !cnf.isAssigned(var)) {
                 if (literal > 0) {
                     pos_count[var]++;
                 } else {
@@ -168,18 +181,14 @@ void OptimizedDPLL::calculateLiteralCounts() {
 }
 
 int OptimizedDPLL::selectVariable() {
-    // 求解初期使用MOM启发式（快速），后期使用VSIDS（适应性强）
-    if (decision_count < cnf.num_vars / 4) {
-        // 初期：优先使用MOM启发式
-        int mom_var = selectVariableMOM();
-        if (mom_var != 0) return mom_var;
-    }
-    
-    // 使用VSIDS快速选择
+    // 决策只走增量维护的VSIDS堆（O(log V)），不再按节点全量重算
+    // 文字计数：MOM的calculateLiteralCounts是对整个公式的扫描，
+    // 放在每次决策里会成为分支选择的主导成本
     int var = selectVariableVSIDS();
     if (var != 0) return var;
-    
-    // 备用：MOM启发式（更快速）
+
+    // 备用：堆耗尽时退回MOM（正常情况下回溯会把变量重新入堆，
+    // 走到这里意味着变量已全部赋值或堆状态异常，频率可忽略）
     return selectVariableMOM();
 }
 
@@ -187,7 +196,7 @@ bool OptimizedDPLL::pureLiteralElimination() {
     calculateLiteralCounts();
     
     for (int i = 1; i <= cnf.num_vars; i++) {
-        if (!cnf.is_assigned[i]) {
+        if (!cnf.isAssigned(i)) {
             if (pos_count[i] > 0 && neg_count[i] == 0) {
                 if (!pushAssignmentWithPropagation(i, true)) {   // 纯正文字
                     return false; // 传播失败
@@ -203,22 +212,12 @@ bool OptimizedDPLL::pureLiteralElimination() {
     return true;
 }
 
-void OptimizedDPLL::updateClauseStatus() {
-    for (size_t i = 0; i < cnf.clauses.size(); ++i) {
-        if (cnf.clause_satisfied[i]) continue;
-        
-        // 检查子句是否已满足
-        for (int literal : cnf.clauses[i]) {
-            int var = abs(literal);
-            
-            if (cnf.is_assigned[var]) {  // 变量已赋值
-                bool lit_true = (literal > 0) ? cnf.assignment[var] : !cnf.assignment[var];
-                if (lit_true) {
-                    cnf.clause_satisfied[i] = true;
-                    break;
-                }
-            }
-        }
+void OptimizedDPLL::markSatisfied(int clause_idx) {
+    // 标记只在从0变1时记日志，回溯按日志逐项清回，
+    // 同一子句在一条赋值路径上至多进出日志一次
+    if (!cnf.clause_satisfied[clause_idx]) {
+        cnf.clause_satisfied[clause_idx] = true;
+        sat_trail.push_back(clause_idx);
     }
 }
 
@@ -227,80 +226,93 @@ bool OptimizedDPLL::unitPropagation() {
     return true; // 传播已经在pushAssignment中通过propagateWatched处理
 }
 
-bool OptimizedDPLL::dpllRecursive() {
-    // 单子句传播
-    if (!unitPropagation()) {
-        return false;
-    }
-    
-    // 更新子句状态
-    updateClauseStatus();
-    
-    // 检查是否已解决
-    bool all_satisfied = true;
-    for (size_t i = 0; i < cnf.clauses.size(); ++i) {
-        if (!cnf.clause_satisfied[i]) {
-            all_satisfied = false;
-            break;
+bool OptimizedDPLL::dpllIterative() {
+    std::vector<DPLLFrame> frames;
+    bool conflict = false;
+
+    // 根层单子句先行断言：单子句的监视项只在其文字被证伪时才
+    // 触发冲突，若不主动断言，搜索要靠先猜错相位再回溯才能学到
+    // 这个必然赋值。一遍顺序扫描把所有单元蕴含灌入传播，冲突
+    // 即不可满足
+    for (int i = 0; i < cnf.num_clauses; ++i) {
+        if (cnf.clauseLen(i) != 1 || cnf.clause_satisfied[i]) continue;
+        int lit = cnf.clauseLits(i)[0];
+        if (cnf.litTrue(lit)) continue;      // 已被先前传播满足
+        if (cnf.litFalse(lit)) return false; // 两个互斥的单子句
+        if (!pushAssignmentWithPropagation(abs(lit), lit > 0)) {
+            return false;
         }
     }
-    
-    if (all_satisfied) {
-        return true;
-    }
-    
-    // 纯文字消除
+
+    // 纯文字消除只在根做一次：它依赖全量文字计数，按节点重复执行
+    // 即每个决策一次O(|公式|)扫描；搜索内部的化简交给监视传播
     if (!pureLiteralElimination()) {
-        return false; // 纯文字消除导致冲突
+        return false;
     }
-    
-    // 重新检查是否所有子句都满足
-    updateClauseStatus();
-    bool all_satisfied_after_pure = true;
-    for (size_t i = 0; i < cnf.clauses.size(); ++i) {
-        if (!cnf.clause_satisfied[i]) {
-            all_satisfied_after_pure = false;
-            break;
+
+    // 满足日志与标记位一一对应（置位入日志、回溯出日志），
+    // 日志长度就是已满足子句数：全满足判定从每节点O(子句数)
+    // 扫描缩为一次整数比较
+    auto allSatisfied = [this]() {
+        return (int)sat_trail.size() == cnf.num_clauses;
+    };
+
+    while (true) {
+        // 协作取消：另一并行分支已求出解时尽快退出
+        // relaxed load在命中时只是一次可预测分支，代价约1周期
+        if (stop_flag && stop_flag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        if (!conflict) {
+            // 求值当前节点：满足标记由传播顺手落位、回溯按日志
+            // 逐项撤销（markSatisfied/backtrack），任何路径都不做
+            // 全量重扫；标记是保守的（可能漏标不会错标），漏标只会
+            // 让搜索多走几步，由下面selectVariable()==0时的
+            // 完整检查兜底
+            if (allSatisfied()) return true;
+
+            int var = selectVariable();
+            if (var == 0) {
+                // 没有未赋值变量，检查是否全部满足
+                if (cnf.allClausesSatisfied()) return true;
+                conflict = true;
+            } else {
+                decision_count++;
+
+                // 压入决策帧并先试保存的相位
+                size_t mark = getCurrentLevel();
+                bool first = saved_phase[var] != 0;
+                frames.push_back({var, mark, first, false});
+                if (!pushAssignmentWithPropagation(var, first)) {
+                    conflict = true;
+                }
+            }
+        } else {
+            // 冲突：回溯到最近一个还有未试分支的决策点并翻转
+            conflict = false;
+            bool resumed = false;
+            while (!frames.empty()) {
+                DPLLFrame& f = frames.back();
+                backtrack(f.trail_mark);
+                if (!f.tried_second) {
+                    f.tried_second = true;
+                    if (pushAssignmentWithPropagation(f.var, !f.first_phase)) {
+                        resumed = true;
+                        break;
+                    }
+                    // 相反分支传播立即冲突，清理后继续向上回溯
+                    backtrack(f.trail_mark);
+                }
+                frames.pop_back();
+            }
+            if (!resumed) return false;  // 搜索树耗尽，不可满足
         }
     }
-    if (all_satisfied_after_pure) {
-        return true;
-    }
-    
-    // 选择变量进行分支
-    int var = selectVariable();
-    if (var == 0) {
-        // 没有未赋值变量，检查是否全部满足
-        return cnf.allClausesSatisfied();
-    }
-    
-    // 增加决策计数
-    decision_count++;
-    
-    // 记录当前决策层级
-    size_t decision_level = getCurrentLevel();
-    
-    // 分支1：var = true
-    if (!pushAssignmentWithPropagation(var, true)) {
-        // 传播失败，回溯并尝试另一个分支
-        backtrack(decision_level);
-    } else if (dpllRecursive()) {
-        return true;
-    } else {
-        // 回溯并尝试分支2：var = false
-        backtrack(decision_level);
-    }
-    
-    // 分支2：var = false
-    if (!pushAssignmentWithPropagation(var, false)) {
-        return false; // 两个分支都失败
-    }
-    
-    return dpllRecursive();
 }
 
 bool OptimizedDPLL::solve() {
-    return dpllRecursive();
+    return dpllIterative();
 }
 
 void OptimizedDPLL::printStats() const {
@@ -308,15 +320,12 @@ void OptimizedDPLL::printStats() const {
     std::cout << "变量数: " << cnf.num_vars << "\n";
     std::cout << "子句数: " << cnf.num_clauses << "\n";
     
-    int satisfied_count = 0;
-    for (bool sat : cnf.clause_satisfied) {
-        if (sat) satisfied_count++;
-    }
-    std::cout << "已满足子句数: " << satisfied_count << "/" << cnf.num_clauses << "\n";
+    // 日志长度即已满足子句数，无需扫描标记数组
+    std::cout << "已满足子句数: " << sat_trail.size() << "/" << cnf.num_clauses << "\n";
     
     int assigned_count = 0;
     for (int i = 1; i <= cnf.num_vars; i++) {
-        if (cnf.is_assigned[i]) assigned_count++;
+        if (cnf.isAssigned(i)) assigned_count++;
     }
     std::cout << "已赋值变量数: " << assigned_count << "/" << cnf.num_vars << "\n";
 }
@@ -324,18 +333,14 @@ void OptimizedDPLL::printStats() const {
 // ==================== 增量回溯实现 ====================
 
 void OptimizedDPLL::pushAssignment(int var, bool value) {
-    // 记录变更前的状态
-    AssignmentChange change;
-    change.var = var;
-    change.was_assigned = cnf.is_assigned[var];
-    change.old_value = cnf.assignment[var];
-    
-    // 将变更记录推入栈
-    undo_stack.push_back(change);
-    
-    // 执行赋值
-    cnf.is_assigned[var] = true;
-    cnf.assignment[var] = value;
+    // 赋值单调：变量此前必未赋值，栈上只需记录变量号；
+    // 同步记下此刻的满足日志长度，回溯时按它撤销标记
+    trail_sat_mark.push_back((uint32_t)sat_trail.size());
+    trail.push_back(var);
+
+    // 执行赋值并记录相位
+    cnf.val[var] = value ? OptimizedCNF::VAL_TRUE : OptimizedCNF::VAL_FALSE;
+    saved_phase[var] = value ? 1 : 0;
 }
 
 bool OptimizedDPLL::pushAssignmentWithPropagation(int var, bool value) {
@@ -347,45 +352,88 @@ bool OptimizedDPLL::pushAssignmentWithPropagation(int var, bool value) {
 }
 
 void OptimizedDPLL::backtrack(size_t target_level) {
-    // 回溯到指定层级
-    while (undo_stack.size() > target_level) {
-        AssignmentChange change = undo_stack.back();
-        undo_stack.pop_back();
-        
-        // 恢复变量状态
-        cnf.is_assigned[change.var] = change.was_assigned;
-        cnf.assignment[change.var] = change.old_value;
+    if (trail.size() <= target_level) return;
+
+    // 先按日志撤销目标时刻之后落下的满足标记：标记只在被撤销的
+    // 赋值之后置位，弹回到目标赋值前的日志长度即恢复一致，
+    // 取代原来O(总文字数)的全量清零加重扫
+    size_t sat_target = trail_sat_mark[target_level];
+    while (sat_trail.size() > sat_target) {
+        cnf.clause_satisfied[sat_trail.back()] = false;
+        sat_trail.pop_back();
     }
-    
-    // 重新计算子句状态
-    std::fill(cnf.clause_satisfied.begin(), cnf.clause_satisfied.end(), false);
-    updateClauseStatus();
-}
 
-// ==================== 预处理和VSIDS优化实现 ====================
+    // 回溯到指定层级：撤销赋值只需清回VAL_UNSET
+    while (trail.size() > target_level) {
+        int var = trail.back();
+        trail.pop_back();
 
-void OptimizedDPLL::buildVarClauseMapping() {
-    var_to_clauses.resize(cnf.num_vars + 1);
-    
-    for (int clause_idx = 0; clause_idx < static_cast<int>(cnf.clauses.size()); ++clause_idx) {
-        for (int literal : cnf.clauses[clause_idx]) {
-            int var = abs(literal);
-            var_to_clauses[var].push_back({clause_idx, literal});
-        }
+        cnf.val[var] = OptimizedCNF::VAL_UNSET;
+
+        // 撤销赋值的变量重新进入VSIDS顺序堆
+        heapInsert(var);
     }
+    trail_sat_mark.resize(target_level);
 }
 
+// ==================== 预处理和VSIDS优化实现 ====================
+
 void OptimizedDPLL::bumpActivity(int var) {
     activity[var] += activity_inc;
-    
+
     // 防止数值溢出
     if (activity[var] > 1e100) {
-        // 重新归一化所有活跃度
+        // 重新归一化所有活跃度（等比缩放不改变堆序，无需重建堆）
         for (int i = 1; i <= cnf.num_vars; ++i) {
             activity[i] *= 1e-100;
         }
         activity_inc *= 1e-100;
     }
+
+    // 活跃度只增不减，在堆中就地上滤即可，O(log V)
+    if (heap_pos[var] != -1) {
+        heapSiftUp(heap_pos[var]);
+    }
+}
+
+// ==================== VSIDS顺序堆实现 ====================
+
+void OptimizedDPLL::heapSiftUp(int idx) {
+    int var = order_heap[idx];
+    while (idx > 0) {
+        int parent = (idx - 1) / 2;
+        if (activity[order_heap[parent]] >= activity[var]) break;
+        order_heap[idx] = order_heap[parent];
+        heap_pos[order_heap[idx]] = idx;
+        idx = parent;
+    }
+    order_heap[idx] = var;
+    heap_pos[var] = idx;
+}
+
+void OptimizedDPLL::heapSiftDown(int idx) {
+    int var = order_heap[idx];
+    int n = (int)order_heap.size();
+    while (2 * idx + 1 < n) {
+        int child = 2 * idx + 1;
+        if (child + 1 < n &&
+            activity[order_heap[child + 1]] > activity[order_heap[child]]) {
+            child++;
+        }
+        if (activity[order_heap[child]] <= activity[var]) break;
+        order_heap[idx] = order_heap[child];
+        heap_pos[order_heap[idx]] = idx;
+        idx = child;
+    }
+    order_heap[idx] = var;
+    heap_pos[var] = idx;
+}
+
+void OptimizedDPLL::heapInsert(int var) {
+    if (heap_pos[var] != -1) return;
+    order_heap.push_back(var);
+    heap_pos[var] = (int)order_heap.size() - 1;
+    heapSiftUp(heap_pos[var]);
 }
 
 void OptimizedDPLL::decayActivity() {
@@ -399,17 +447,20 @@ void OptimizedDPLL::decayActivity() {
 }
 
 int OptimizedDPLL::selectVariableVSIDS() {
-    int best_var = 0;
-    double max_activity = -1.0;
-    
-    for (int i = 1; i <= cnf.num_vars; ++i) {
-        if (!cnf.is_assigned[i] && activity[i] > max_activity) {
-            max_activity = activity[i];
-            best_var = i;
+    // 懒删除：堆顶若已赋值则直接丢弃，回溯撤销赋值时重新入堆，
+    // 把原来每次决策的O(V)全量扫描降为O(log V)
+    while (!order_heap.empty()) {
+        int var = order_heap[0];
+        heap_pos[var] = -1;
+        order_heap[0] = order_heap.back();
+        order_heap.pop_back();
+        if (!order_heap.empty()) {
+            heap_pos[order_heap[0]] = 0;
+            heapSiftDown(0);
         }
+        if (!cnf.isAssigned(var)) return var;
     }
-    
-    return best_var;
+    return 0;
 }
 
 int OptimizedDPLL::selectVariableMOM() {
@@ -419,7 +470,7 @@ int OptimizedDPLL::selectVariableMOM() {
     int max_mom = -1;
     
     for (int i = 1; i <= cnf.num_vars; ++i) {
-        if (!cnf.is_assigned[i]) {
+        if (!cnf.isAssigned(i)) {
             // MOM启发式：(pos_count * neg_count) + pos_count + neg_count
             // 优先选择在正负文字出现频率都高的变量
             int mom_score = pos_count[i] * neg_count[i] + pos_count[i] + neg_count[i];
@@ -433,13 +484,12 @@ int OptimizedDPLL::selectVariableMOM() {
     return best_var;
 }
 
-void OptimizedDPLL::handleConflict(const std::vector<int>& conflict_clause) {
+void OptimizedDPLL::handleConflict(const int* lits, int n) {
     // 提升冲突子句中所有变量的活跃度
-    for (int literal : conflict_clause) {
-        int var = abs(literal);
-        bumpActivity(var);
+    for (int k = 0; k < n; ++k) {
+        bumpActivity(abs(lits[k]));
     }
-    
+
     // 定期衰减活跃度
     decayActivity();
 }
@@ -454,135 +504,193 @@ int OptimizedDPLL::literalToIndex(int literal) const {
 void OptimizedDPLL::initWatchedLiterals() {
     // 初始化watch列表，大小为 2 * num_vars + 1（索引从1开始）
     watches.resize(2 * cnf.num_vars + 1);
-    clause_watched.resize(cnf.clauses.size(), {0, 0});
-    
-    for (int i = 0; i < static_cast<int>(cnf.clauses.size()); ++i) {
-        const auto& clause = cnf.clauses[i];
-        if (clause.size() >= 2) {
-            // 选择前两个文字作为watched literals
+    clause_watched.resize(cnf.num_clauses, {0, 0});
+
+    // 每个文字的监视项数可提前精确统计（每子句至多2个监视），
+    // 先计数后reserve，省去成百上千条监视列表各自的多轮扩容
+    std::vector<uint32_t> watch_count(watches.size(), 0);
+    for (int i = 0; i < cnf.num_clauses; ++i) {
+        const int* clause = cnf.clauseLits(i);
+        const int len = cnf.clauseLen(i);
+        if (len >= 2) {
+            watch_count[literalToIndex(clause[0])]++;
+            watch_count[literalToIndex(clause[1])]++;
+        } else if (len == 1) {
+            watch_count[literalToIndex(clause[0])]++;
+        }
+    }
+    for (size_t idx = 1; idx < watches.size(); ++idx) {
+        watches[idx].reserve(watch_count[idx]);
+    }
+
+    for (int i = 0; i < cnf.num_clauses; ++i) {
+        const int* clause = cnf.clauseLits(i);
+        const int len = cnf.clauseLen(i);
+        if (len == 2) {
+            // 二元子句：把另一个文字内联进监视项，传播时不再访问子句
+            clause_watched[i] = {clause[0], clause[1]};
+            watches[literalToIndex(clause[0])].push_back({clause[1], BINARY_CLAUSE});
+            watches[literalToIndex(clause[1])].push_back({clause[0], BINARY_CLAUSE});
+        } else if (len > 2) {
+            // 选择前两个文字作为watched literals，互为阻塞文字
             int watch1 = clause[0];
             int watch2 = clause[1];
-            
+
             clause_watched[i] = {watch1, watch2};
-            
-            // 添加到对应的watch列表
-            int idx1 = literalToIndex(watch1);
-            int idx2 = literalToIndex(watch2);
-            
-            watches[idx1].push_back(i);
-            watches[idx2].push_back(i);
-        } else if (clause.size() == 1) {
+
+            watches[literalToIndex(watch1)].push_back({watch2, i});
+            watches[literalToIndex(watch2)].push_back({watch1, i});
+        } else if (len == 1) {
             // 单子句特殊处理
             int watch1 = clause[0];
             clause_watched[i] = {watch1, 0};
-            
-            int idx1 = literalToIndex(watch1);
-            watches[idx1].push_back(i);
+
+            watches[literalToIndex(watch1)].push_back({0, i});
         }
     }
 }
 
-bool OptimizedDPLL::updateWatch(int clause_idx, int old_watch_literal) {
-    const auto& clause = cnf.clauses[clause_idx];
+HOT_FUNC int OptimizedDPLL::updateWatch(int clause_idx, int old_watch_literal) {
+    const int* clause = cnf.clauseLits(clause_idx);
+    const int len = cnf.clauseLen(clause_idx);
     auto& watched = clause_watched[clause_idx];
-    
+
     // 确定另一个watched literal
     int other_watch = (watched.first == old_watch_literal) ? watched.second : watched.first;
-    
-    // 寻找新的watched literal
-    for (int literal : clause) {
+
+    // 寻找新的watched literal（子句文字在扁平池中连续，顺序扫描）
+    for (int k = 0; k < len; ++k) {
+        int literal = clause[k];
         if (literal != old_watch_literal && literal != other_watch) {
-            int var_in_lit = abs(literal);
-            
-            // 检查这个文字是否已经满足子句
-            if (cnf.is_assigned[var_in_lit]) {
-                bool var_value = cnf.assignment[var_in_lit];
-                bool lit_value = (literal > 0) ? var_value : !var_value;
-                if (lit_value) {
-                    // 子句已满足
-                    cnf.clause_satisfied[clause_idx] = true;
-                    return true;
-                }
-            } else {
+            uint8_t v = cnf.val[abs(literal)];
+
+            // 检查这个文字是否已经满足子句（目标值无分支合成）
+            if (v == (uint8_t)(OptimizedCNF::VAL_FALSE + (literal > 0))) {
+                // 子句已满足，监视项留在原列表
+                markSatisfied(clause_idx);
+                return 1;
+            }
+            if (v == OptimizedCNF::VAL_UNSET) {
                 // 找到新的未赋值文字作为watched literal
                 if (watched.first == old_watch_literal) {
                     watched.first = literal;
                 } else {
                     watched.second = literal;
                 }
-                
-                // 更新watch列表
-                int old_idx = literalToIndex(old_watch_literal);
-                int new_idx = literalToIndex(literal);
-                
-                // 从旧的watch列表中移除
-                auto& old_watch_list = watches[old_idx];
-                old_watch_list.erase(
-                    std::remove(old_watch_list.begin(), old_watch_list.end(), clause_idx),
-                    old_watch_list.end()
-                );
-                
-                // 添加到新的watch列表
-                watches[new_idx].push_back(clause_idx);
-                
-                return true;
+
+                // 只向新列表登记；旧列表的监视项由propagateWatched
+                // 在原地压缩时丢弃，免去一次O(列表长度)的erase扫描
+                watches[literalToIndex(literal)].push_back({other_watch, clause_idx});
+
+                return 2;
             }
         }
     }
-    
-    return false; // 没有找到新的watched literal
+
+    return 0; // 没有找到新的watched literal
 }
 
-bool OptimizedDPLL::propagateWatched(int var, bool value) {
-    // 构造被赋值为false的文字
-    int false_lit = value ? -var : var;
-    int false_idx = literalToIndex(false_lit);
-    
-    // 创建watch列表的副本，因为在迭代过程中可能会修改
-    std::vector<int> watched_clauses = watches[false_idx];
-    
-    for (int clause_idx : watched_clauses) {
-        if (cnf.clause_satisfied[clause_idx]) continue;
-        
-        const auto& clause = cnf.clauses[clause_idx];
-        const auto& watched = clause_watched[clause_idx];
-        
-        // 尝试更新watch
-        if (!updateWatch(clause_idx, false_lit)) {
-            // 无法找到新的watch，检查另一个watched literal
-            int other_watch = (watched.first == false_lit) ? watched.second : watched.first;
-            
-            if (other_watch == 0) {
-                // 单子句冲突
-                handleConflict(clause);
-                return false;
-            }
-            
-            int other_var = abs(other_watch);
-            if (cnf.is_assigned[other_var]) {
-                // 检查是否冲突
-                bool other_value = cnf.assignment[other_var];
-                bool other_sign = other_watch > 0;
-                if ((other_sign && !other_value) || (!other_sign && other_value)) {
-                    // 冲突
-                    handleConflict(clause);
-                    return false;
+HOT_FUNC bool OptimizedDPLL::propagateWatched(int var, bool value) {
+    // 显式传播队列取代逐蕴含递归：长蕴含链不再逐层压C++栈帧，
+    // 编译器也能把内层监视循环保持在一个紧凑帧里。
+    // 队列存"刚变真的文字"，缓冲跨调用复用
+    prop_queue.clear();
+    prop_queue.push_back(value ? var : -var);
+    size_t qhead = 0;
+
+    while (qhead < prop_queue.size()) {
+        int false_lit = -prop_queue[qhead++];
+        int false_idx = literalToIndex(false_lit);
+
+        // 原地读写双指针压缩，取代整表复制：监视迁走的项直接丢弃，
+        // 留下的项前移。本轮只改别的文字的列表——false_lit已赋假，
+        // 不会有监视迁入（新监视必须未赋值），队列推进安全
+        auto& ws = watches[false_idx];
+        size_t rd = 0, wr = 0;
+
+        // 冲突提前返回时把未处理的监视项搬齐再收尾，列表保持完整
+        auto bail = [&ws, &rd, &wr]() {
+            while (rd < ws.size()) ws[wr++] = ws[rd++];
+            ws.resize(wr);
+        };
+
+        while (rd < ws.size()) {
+            Watcher w = ws[rd++];
+            if (w.clause_idx == BINARY_CLAUSE) {
+                ws[wr++] = w;  // 二元监视项永不迁移
+                // 二元子句：另一个文字内联在监视项里，不访问子句存储
+                int other = w.blocker;
+                int other_var = abs(other);
+                if (cnf.isAssigned(other_var)) {
+                    if (cnf.litFalse(other)) {
+                        const int bin_clause[2] = {false_lit, other};
+                        handleConflict(bin_clause, 2);
+                        bail();
+                        return false;
+                    }
+                    continue;  // 子句已满足
                 }
-                // 否则子句已满足
-                cnf.clause_satisfied[clause_idx] = true;
-            } else {
-                // 单子句传播
-                bool required_value = other_watch > 0;
+                // 单子句传播：赋值后入队，由外层循环接续处理
+                bool required_value = other > 0;
                 pushAssignment(other_var, required_value);
-                
-                // 递归传播
-                if (!propagateWatched(other_var, required_value)) {
+                prop_queue.push_back(required_value ? other_var : -other_var);
+                continue;
+            }
+
+            int clause_idx = w.clause_idx;
+            if (cnf.clause_satisfied[clause_idx]) { ws[wr++] = w; continue; }
+
+            // 阻塞文字为真则子句已满足，直接跳过，避免访问子句数据
+            // （传播中最常见的情况，标注为可能命中的分支）；
+            // 顺手落下满足标记，回溯时按日志撤销
+            if (LIKELY(w.blocker != 0)) {
+                if (cnf.litTrue(w.blocker)) {
+                    markSatisfied(clause_idx);
+                    ws[wr++] = w;
+                    continue;
+                }
+            }
+
+            const int* clause = cnf.clauseLits(clause_idx);
+            const int clause_len = cnf.clauseLen(clause_idx);
+            const auto& watched = clause_watched[clause_idx];
+
+            // 尝试更新watch：迁移成功则丢弃当前监视项，其余情况原地保留
+            int st = updateWatch(clause_idx, false_lit);
+            if (st == 2) continue;
+            ws[wr++] = w;
+            if (st == 0) {
+                // 无法找到新的watch，检查另一个watched literal
+                int other_watch = (watched.first == false_lit) ? watched.second : watched.first;
+
+                if (UNLIKELY(other_watch == 0)) {
+                    // 单子句冲突
+                    handleConflict(clause, clause_len);
+                    bail();
                     return false;
                 }
+
+                int other_var = abs(other_watch);
+                if (cnf.isAssigned(other_var)) {
+                    if (cnf.litFalse(other_watch)) {
+                        // 冲突
+                        handleConflict(clause, clause_len);
+                        bail();
+                        return false;
+                    }
+                    // 否则子句已满足
+                    markSatisfied(clause_idx);
+                } else {
+                    // 单子句传播：同样入队接续
+                    bool required_value = other_watch > 0;
+                    pushAssignment(other_var, required_value);
+                    prop_queue.push_back(required_value ? other_var : -other_var);
+                }
             }
         }
+
+        ws.resize(wr);
     }
-    
     return true;
 }
 
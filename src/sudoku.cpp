@@ -1,88 +1,332 @@
 #include "sudoku.h"
 
+#include <atomic>
+#include <thread>
+
 // 百分号数独特殊窗口位置定义
 int upperWindow[9][2] = { {1,1},{1,2},{1,3},{2,1},{2,2},{2,3},{3,1},{3,2},{3,3} };
 int lowerWindow[9][2] = { {5,5},{5,6},{5,7},{6,5},{6,6},{6,7},{7,5},{7,6},{7,7} };
 
-bool isSafe(int grid[N][N], int row, int col, int num) {
-	// 检查行
-	for (int i = 0; i < N; i++)
-		if (grid[row][i] == num) return false;
+/** @brief 数独CNF的变量总数（谜题变量729 + 辅助变量），由编码器维护 */
+static int sudokuVarCount = 729;
 
-	// 检查列
-	for (int i = 0; i < N; i++)
-		if (grid[i][col] == num) return false;
+bool isSafe(uint8_t grid[N][N], int row, int col, int num) {
+	// 按约束组把已用数字收集成一个9位掩码再一次测试，
+	// 去掉逐格比较的分支（与FillMasks::usedAt同一套判定）
+	uint16_t used = 0;
+
+	// 行与列
+	for (int i = 0; i < N; i++) {
+		used |= (uint16_t)(1u << grid[row][i]);
+		used |= (uint16_t)(1u << grid[i][col]);
+	}
 
-	// 检查3x3宫
+	// 3x3宫
 	int startRow = row - row % 3;
 	int startCol = col - col % 3;
 	for (int i = 0; i < 3; i++)
 		for (int j = 0; j < 3; j++)
-			if (grid[startRow + i][startCol + j] == num) return false;
+			used |= (uint16_t)(1u << grid[startRow + i][startCol + j]);
 
-	// 检查主对角线
+	// 主/副对角线
 	if (row == col)
 		for (int i = 0; i < N; i++)
-			if (grid[i][i] == num) return false;
-
-	// 检查副对角线
+			used |= (uint16_t)(1u << grid[i][i]);
 	if (row + col == N - 1)
 		for (int i = 0; i < N; i++)
-			if (grid[i][N - 1 - i] == num) return false;
+			used |= (uint16_t)(1u << grid[i][N - 1 - i]);
 
-	// 检查上窗口（左上角3x3）
-	if (row >= 1 && row <= 3 && col >= 1 && col <= 3) {
+	// 上窗口（左上角3x3）
+	if (row >= 1 && row <= 3 && col >= 1 && col <= 3)
 		for (int i = 1; i <= 3; i++)
 			for (int j = 1; j <= 3; j++)
-				if (grid[i][j] == num) return false;
-	}
+				used |= (uint16_t)(1u << grid[i][j]);
 
-	// 检查下窗口（右下角3x3）
-	if (row >= 5 && row <= 7 && col >= 5 && col <= 7) {
+	// 下窗口（右下角3x3）
+	if (row >= 5 && row <= 7 && col >= 5 && col <= 7)
 		for (int i = 5; i <= 7; i++)
 			for (int j = 5; j <= 7; j++)
-				if (grid[i][j] == num) return false;
-	}
+				used |= (uint16_t)(1u << grid[i][j]);
 
-	return true;
+	return !(used & (1u << num));
 }
 
-bool fillGrid(int grid[N][N], int row, int col) {
-	if (row == N) return true;
-	if (col == N) return fillGrid(grid, row + 1, 0);
-	if (grid[row][col] != 0) return fillGrid(grid, row, col + 1);
+// ==================== 位掩码填充状态 ====================
+// fillGrid回溯中isSafe被调用O(9^4)次，每次扫描27+个格子；
+// 改为每行/列/宫/对角线/窗口各维护一个uint16_t已用数字掩码，
+// 合法性检查缩减为几次按位或加一次测试
+
+namespace {
+
+/** @brief 数独填充过程的已用数字掩码（位num置1表示num已放置） */
+struct FillMasks {
+	uint16_t row_used[N];
+	uint16_t col_used[N];
+	uint16_t box_used[N];
+	uint16_t diag_used[2];   // [0]主对角线 [1]副对角线
+	uint16_t win_used[2];    // [0]上窗口 [1]下窗口
+
+	/** @brief 格子(r,c)所属的所有约束组的掩码按位或 */
+	uint16_t usedAt(int r, int c) const {
+		uint16_t used = row_used[r] | col_used[c]
+		              | box_used[(r / 3) * 3 + c / 3];
+		if (r == c) used |= diag_used[0];
+		if (r + c == N - 1) used |= diag_used[1];
+		if (r >= 1 && r <= 3 && c >= 1 && c <= 3) used |= win_used[0];
+		if (r >= 5 && r <= 7 && c >= 5 && c <= 7) used |= win_used[1];
+		return used;
+	}
+
+	/** @brief 放置/移除数字num（flip对称，异或即可） */
+	void flip(int r, int c, int num) {
+		uint16_t bit = (uint16_t)(1u << num);
+		row_used[r] ^= bit;
+		col_used[c] ^= bit;
+		box_used[(r / 3) * 3 + c / 3] ^= bit;
+		if (r == c) diag_used[0] ^= bit;
+		if (r + c == N - 1) diag_used[1] ^= bit;
+		if (r >= 1 && r <= 3 && c >= 1 && c <= 3) win_used[0] ^= bit;
+		if (r >= 5 && r <= 7 && c >= 5 && c <= 7) win_used[1] ^= bit;
+	}
+
+	/** @brief 由当前网格初始化全部掩码 */
+	void init(uint8_t grid[N][N]) {
+		memset(this, 0, sizeof(*this));
+		for (int r = 0; r < N; r++)
+			for (int c = 0; c < N; c++)
+				if (grid[r][c] != 0) flip(r, c, grid[r][c]);
+	}
+};
+
+/** @brief 预生成的数字顺序表：进程内用mt19937洗好256个排列，
+ *  填充时轮流取用，把rand()与Fisher-Yates彻底移出回溯热路径 */
+struct DigitPerms {
+	uint8_t perm[256][9];
+
+	DigitPerms() {
+		random_device rd;
+		mt19937 g(rd());
+		for (int i = 0; i < 256; i++) {
+			for (int k = 0; k < 9; k++) perm[i][k] = (uint8_t)(k + 1);
+			shuffle(perm[i], perm[i] + 9, g);
+		}
+	}
+};
+
+DigitPerms digit_perms;
+unsigned perm_counter = 0;
+
+// ==================== 前向检查填充 ====================
+// 纯生成-测试的回溯只有在放置处发现冲突才回头；前向检查在每次
+// 放置后立即从同行/列/宫/对角线/窗口各格的候选域中删去该数字：
+// 某格候选清空即当场失败，候选只剩一个则立刻连锁放置（裸单元），
+// 把矛盾的发现从"试到那格时"提前到"产生矛盾时"
+
+/** @brief 候选域撤销日志项：格子坐标与修改前的域 */
+struct DomainUndo {
+	uint8_t r, c;
+	uint16_t old_dom;
+};
+
+/** @brief 前向检查状态：每格候选数字掩码（位num置1表示num可填） */
+struct ForwardCheck {
+	uint16_t dom[N][N];
+	vector<DomainUndo> log;
+
+	/** @brief 由当前网格初始化全部候选域 */
+	void init(uint8_t grid[N][N]) {
+		FillMasks masks;
+		masks.init(grid);
+		for (int r = 0; r < N; r++)
+			for (int c = 0; c < N; c++)
+				dom[r][c] = grid[r][c] != 0
+					? (uint16_t)(1u << grid[r][c])
+					: (uint16_t)(~masks.usedAt(r, c) & 0x3FEu);
+	}
+
+	/** @brief 回滚候选域到指定日志位置 */
+	void undoTo(size_t mark) {
+		while (log.size() > mark) {
+			DomainUndo u = log.back();
+			log.pop_back();
+			dom[u.r][u.c] = u.old_dom;
+		}
+	}
 
-	int nums[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
-	// 随机打乱数字顺序
-	for (int i = 8; i > 0; i--) {
-		int j = rand() % (i + 1);
-		swap(nums[i], nums[j]);
+	/** @brief 从空格(r,c)的域中删去bit；清空返回false，剩单候选入队 */
+	bool restrictCell(int r, int c, uint16_t bit, uint8_t grid[N][N],
+	                  vector<pair<int, int>>& singles) {
+		if (grid[r][c] != 0 || !(dom[r][c] & bit)) return true;
+		log.push_back({ (uint8_t)r, (uint8_t)c, dom[r][c] });
+		dom[r][c] &= (uint16_t)~bit;
+		if (dom[r][c] == 0) return false;
+		if ((dom[r][c] & (dom[r][c] - 1)) == 0) singles.push_back({ r, c });
+		return true;
 	}
 
+	/** @brief 在(r,c)放入num后，从全部同组格的域中删去num */
+	bool strikePeers(int r, int c, int num, uint8_t grid[N][N],
+	                 vector<pair<int, int>>& singles) {
+		uint16_t bit = (uint16_t)(1u << num);
+		for (int i = 0; i < N; i++) {
+			if (!restrictCell(r, i, bit, grid, singles)) return false;
+			if (!restrictCell(i, c, bit, grid, singles)) return false;
+		}
+		int startRow = r - r % 3, startCol = c - c % 3;
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				if (!restrictCell(startRow + i, startCol + j, bit, grid, singles))
+					return false;
+		if (r == c)
+			for (int i = 0; i < N; i++)
+				if (!restrictCell(i, i, bit, grid, singles)) return false;
+		if (r + c == N - 1)
+			for (int i = 0; i < N; i++)
+				if (!restrictCell(i, N - 1 - i, bit, grid, singles)) return false;
+		if (r >= 1 && r <= 3 && c >= 1 && c <= 3)
+			for (int i = 1; i <= 3; i++)
+				for (int j = 1; j <= 3; j++)
+					if (!restrictCell(i, j, bit, grid, singles)) return false;
+		if (r >= 5 && r <= 7 && c >= 5 && c <= 7)
+			for (int i = 5; i <= 7; i++)
+				for (int j = 5; j <= 7; j++)
+					if (!restrictCell(i, j, bit, grid, singles)) return false;
+		return true;
+	}
+};
+
+/**
+ * @brief 放置数字并做前向检查传播（含裸单元连锁放置）
+ * @param placed 本次放置（含连锁）填入的格子，失败时由调用方清回0
+ * @return 传播中某格候选清空返回false
+ */
+bool placeWithPropagation(uint8_t grid[N][N], ForwardCheck& fc, int r, int c, int num,
+                          vector<pair<int, int>>& placed) {
+	grid[r][c] = (uint8_t)num;
+	placed.push_back({ r, c });
+	fc.log.push_back({ (uint8_t)r, (uint8_t)c, fc.dom[r][c] });
+	fc.dom[r][c] = (uint16_t)(1u << num);
+
+	vector<pair<int, int>> singles;
+	if (!fc.strikePeers(r, c, num, grid, singles)) return false;
+
+	while (!singles.empty()) {
+		int sr = singles.back().first;
+		int sc = singles.back().second;
+		singles.pop_back();
+		if (grid[sr][sc] != 0) continue;
+		int snum = CTZ32(fc.dom[sr][sc]);
+		grid[sr][sc] = (uint8_t)snum;
+		placed.push_back({ sr, sc });
+		if (!fc.strikePeers(sr, sc, snum, grid, singles)) return false;
+	}
+	return true;
+}
+
+/** @brief 前向检查版回溯填充（数字顺序取自预洗牌排列表） */
+bool fillGridFC(uint8_t grid[N][N], ForwardCheck& fc) {
+	int row = -1, col = -1;
+	for (int idx = 0; idx < N * N; idx++)
+		if (grid[idx / N][idx % N] == 0) {
+			row = idx / N;
+			col = idx % N;
+			break;
+		}
+	if (row == -1) return true;              // 无空格，已填满
+
+	const uint8_t* nums = digit_perms.perm[perm_counter++ & 255u];
 	for (int i = 0; i < 9; i++) {
-		if (isSafe(grid, row, col, nums[i])) {
-			grid[row][col] = nums[i];
-			if (fillGrid(grid, row, col + 1)) return true;
-			grid[row][col] = 0;
+		int num = nums[i];
+		if (!(fc.dom[row][col] & (1u << num))) continue;
+
+		size_t mark = fc.log.size();
+		vector<pair<int, int>> placed;
+		if (placeWithPropagation(grid, fc, row, col, num, placed) &&
+		    fillGridFC(grid, fc)) {
+			return true;
 		}
+		for (size_t k = 0; k < placed.size(); k++)
+			grid[placed[k].first][placed[k].second] = 0;
+		fc.undoTo(mark);
 	}
 	return false;
 }
 
+/** @brief 返回候选最少的空格坐标；无空格时row置-1 */
+void findMostConstrainedCell(uint8_t grid[N][N], const ForwardCheck& fc,
+                             int& row, int& col) {
+	row = -1;
+	col = -1;
+	int best = 10;
+	for (int r = 0; r < N; r++)
+		for (int c = 0; c < N; c++)
+			if (grid[r][c] == 0) {
+				int n = POPCNT32(fc.dom[r][c]);
+				if (n < best) {
+					best = n;
+					row = r;
+					col = c;
+				}
+			}
+}
+
+/**
+ * @brief 计数版前向检查搜索：统计补全方式数，达到上限即截断
+ * @details MRV选格（候选最少的空格优先分支），候选按位枚举；
+ *          与fillGridFC共用放置传播与撤销日志。global_count为
+ *          并行枚举的跨线程解计数：每找到一个解累加一次，
+ *          兄弟子树够数后各线程在分支点协作退出
+ */
+int countCompletions(uint8_t grid[N][N], ForwardCheck& fc, int maxSolutions,
+                     std::atomic<int>* global_count = nullptr) {
+	int row, col;
+	findMostConstrainedCell(grid, fc, row, col);
+	if (row == -1) {                         // 无空格，恰好一种补全
+		if (global_count != nullptr)
+			global_count->fetch_add(1, std::memory_order_relaxed);
+		return 1;
+	}
+
+	int count = 0;
+	uint16_t cand = fc.dom[row][col];
+	while (cand != 0 && count < maxSolutions) {
+		if (global_count != nullptr &&
+		    global_count->load(std::memory_order_relaxed) >= maxSolutions)
+			break;                           // 全局已够数，剩余子树不再展开
+
+		int num = CTZ32(cand);
+		cand &= (uint16_t)(cand - 1);
+
+		size_t mark = fc.log.size();
+		vector<pair<int, int>> placed;
+		if (placeWithPropagation(grid, fc, row, col, num, placed))
+			count += countCompletions(grid, fc, maxSolutions - count, global_count);
+		for (size_t k = 0; k < placed.size(); k++)
+			grid[placed[k].first][placed[k].second] = 0;
+		fc.undoTo(mark);
+	}
+	return count;
+}
+
+} // namespace
+
+bool fillGrid(uint8_t grid[N][N], int row, int col) {
+	(void)row;
+	(void)col;     // 前向检查版自行定位空格，起始坐标参数仅为兼容保留
+	ForwardCheck fc;
+	fc.init(grid);
+	return fillGridFC(grid, fc);
+}
+
 // 向 CNF 中添加单文字子句
 void addClauseLiteral(SATList*& cnf, int literal) {
-	// 创建新的子句节点
-	SATList* newClause = (SATList*)malloc(sizeof(SATList));
-	if (!newClause) return; // 内存分配失败
+	// 子句与文字节点统一取自slab节点池（与destroyClause的归还配对）
+	SATList* newClause = allocList();
 	newClause->head = nullptr;
 	newClause->next = nullptr;
+	newClause->prev = nullptr;
 
-	// 创建文字节点
-	SATNode* newNode = (SATNode*)malloc(sizeof(SATNode));
-	if (!newNode) {
-		free(newClause);
-		return;
-	}
+	SATNode* newNode = allocNode();
 	newNode->data = literal;
 	newNode->next = nullptr;
 
@@ -94,6 +338,7 @@ void addClauseLiteral(SATList*& cnf, int literal) {
 	}
 	else {
 		newClause->next = cnf;
+		cnf->prev = newClause;
 		cnf = newClause;
 	}
 }
@@ -101,12 +346,12 @@ void addClauseLiteral(SATList*& cnf, int literal) {
 
 /*
  * 函数名称: generatePuzzle
- * 接受参数: int full[N][N] 完整数独, int puzzle[N][N] 谜题, int clues 提示数
+ * 接受参数: uint8_t full[N][N] 完整数独, uint8_t puzzle[N][N] 谜题, int clues 提示数
  * 函数功能: 从完整数独中挖洞生成题目，确保有解且解唯一
  * 返回值: void
  */
 
-void generatePuzzle(int full[N][N], int puzzle[N][N], int toRemove) {
+void generatePuzzle(uint8_t full[N][N], uint8_t puzzle[N][N], int toRemove) {
 	// 先复制完整数独
 	for (int i = 0; i < N; i++)
 		for (int j = 0; j < N; j++)
@@ -135,8 +380,26 @@ void generatePuzzle(int full[N][N], int puzzle[N][N], int toRemove) {
     for (int i = 0; i < N * N; i++) {
         positions[i][0] = posVec[i].first;
         positions[i][1] = posVec[i].second;
-    }	int removed = 0;
+    }
 
+	// 结构约束只建库一次：提示数字以假设文字传入增量求解器，
+	// 逐洞的两次可满足性检查共享学习子句、监视结构与VSIDS状态，
+	// 不再每次尝试都重建并销毁整套CNF
+	SATList* structuralCNF = nullptr;
+	uint8_t emptyPuzzle[N][N] = { {0} };
+	sudokuToCNF(emptyPuzzle, structuralCNF);
+	setSudokuGlobals();
+	IncrementalSolver* solver = incrementalCreate(structuralCNF);
+	destroyClause(structuralCNF);
+
+	// 按实际变量数精确分配：结构变量sudokuVarCount个，再留N*N个
+	// 激活文字的余量（每次挖空尝试至多新增一个）。calloc零初始化
+	// 即"未赋值=假"，求解成功时所有变量都已赋值，无需逐元素预置
+	int* value1 = (int*)calloc(sudokuVarCount + 1 + N * N, sizeof(int));
+	vector<int> assumptions;
+	assumptions.reserve(N * N);
+
+	int removed = 0;
 	for (int idx = 0; idx < N * N && removed < toRemove; idx++) {
 		int r = positions[idx][0];
 		int c = positions[idx][1];
@@ -146,85 +409,68 @@ void generatePuzzle(int full[N][N], int puzzle[N][N], int toRemove) {
 		int backup = puzzle[r][c];
 		puzzle[r][c] = 0;
 
-		// 生成 CNF 并求解第一次
-		SATList* cnf1 = nullptr;
-		sudokuToCNF(puzzle, cnf1);
-
-		// 设置数独求解的全局变量
-		setSudokuGlobals();
-
-		int* value1 = (int*)malloc(sizeof(int) * MAX_VAR);
-		for (int k = 0; k < MAX_VAR; k++) value1[k] = 1;
+		// 第一次求解：当前提示下是否仍有解
+		assumptions.clear();
+		for (int i = 0; i < N; i++)
+			for (int j = 0; j < N; j++)
+				if (puzzle[i][j] != 0)
+					assumptions.push_back(varIndex(i, j, puzzle[i][j]));
 
-		int result1 = DPLL_Optimized(cnf1, value1);
-		destroyClause(cnf1);
+		int result1 = incrementalSolve(solver, assumptions.data(),
+		                               (int)assumptions.size(), value1);
 
 		if (result1 != 1) {
 			// 无解，回滚
 			puzzle[r][c] = backup;
-			free(value1);
 			continue;
 		}
 
-		// 构造第二个 CNF 来检查是否存在第二解
-		SATList* cnf2 = nullptr;
-		sudokuToCNF(puzzle, cnf2);
-
-		// 添加否定第一个解的约束
-		SATList* negClause = (SATList*)malloc(sizeof(SATList));
-		negClause->head = nullptr;
-		negClause->next = nullptr;
-
-		SATNode* negHead = nullptr;
-		for (int row = 0; row < N; row++) {
-			for (int col = 0; col < N; col++) {
-				if (puzzle[row][col] == 0) {
-					for (int num = 1; num <= 9; num++) {
+		// 第二次求解：否定第一个解，检查是否存在第二解。
+		// 否定子句挂在新分配的激活文字上：本次求解假设激活文字
+		// 为真使其生效，检查完层0断言其为假将其永久关闭，
+		// 不影响后续尝试的正确性
+		vector<int> negation;
+		for (int row = 0; row < N; row++)
+			for (int col = 0; col < N; col++)
+				if (puzzle[row][col] == 0)
+					for (int num = 1; num <= 9; num++)
 						if (value1[varIndex(row, col, num)] == 1) {
-							SATNode* node = (SATNode*)malloc(sizeof(SATNode));
-							node->data = -varIndex(row, col, num);
-							node->next = negHead;
-							negHead = node;
+							negation.push_back(-varIndex(row, col, num));
 							break;
 						}
-					}
-				}
-			}
-		}
-
-		if (negHead != nullptr) {
-			negClause->head = negHead;
-			addClause(negClause, cnf2);
 
-			// 设置数独求解的全局变量
-			setSudokuGlobals();
+		if (!negation.empty()) {
+			int activation = incrementalNewVar(solver);
+			negation.push_back(-activation);
+			incrementalAddClause(solver, negation.data(), (int)negation.size());
 
-			int* value2 = (int*)malloc(sizeof(int) * MAX_VAR);
-			for (int k = 0; k < MAX_VAR; k++) value2[k] = 1;
+			assumptions.push_back(activation);
+			int result2 = incrementalSolve(solver, assumptions.data(),
+			                               (int)assumptions.size(), value1);
 
-			int result2 = DPLL_Optimized(cnf2, value2);
-			free(value2);
+			int deactivate = -activation;
+			incrementalAddClause(solver, &deactivate, 1);
 
 			if (result2 == 1) {
 				// 有第二解，回滚
 				puzzle[r][c] = backup;
 			}
-            else {
-                // 唯一解，确认挖空
-                removed++;
-                cout << "Successfully removed position (" << r << ", " << c << "), removed " << removed << " cells" << endl;
-            }
-        }
-        else {
-            // 不需要否定的文字，解唯一
-            removed++;
-            cout << "Successfully removed position (" << r << ", " << c << "), removed " << removed << " cells" << endl;
-        }
-
-		destroyClause(cnf2);
-		free(value1);
+			else {
+				// 唯一解，确认挖空
+				removed++;
+				cout << "Successfully removed position (" << r << ", " << c << "), removed " << removed << " cells" << endl;
+			}
+		}
+		else {
+			// 不需要否定的文字，解唯一
+			removed++;
+			cout << "Successfully removed position (" << r << ", " << c << "), removed " << removed << " cells" << endl;
+		}
 	}
 
+	incrementalDestroy(solver);
+	free(value1);
+
     cout << "Final removal completed, removed " << removed << " cells, remaining hints " << (N * N - removed) << endl;
     
     // 保存最终生成的数独谜题CNF
@@ -242,7 +488,7 @@ void generatePuzzle(int full[N][N], int puzzle[N][N], int toRemove) {
     destroyClause(finalCNF);
 }
 
-void printSudoku(int grid[N][N]) {
+void printSudoku(uint8_t grid[N][N]) {
 	for (int i = 0; i < N; i++) {
 		if (i % 3 == 0 && i != 0) {
 			cout << "------+-------+------" << endl;
@@ -259,14 +505,11 @@ void printSudoku(int grid[N][N]) {
 	cout << endl;
 }
 
-int varIndex(int row, int col, int num) {
-	return row * 81 + col * 9 + num; // 1~729
-}
-
 // 设置数独求解的全局变量
 void setSudokuGlobals() {
     extern int boolCount, clauseCount;
-    boolCount = 729;  // 9x9x9 = 729 variables for sudoku
+    // 谜题变量729个，外加AMO顺序计数器编码的辅助变量
+    boolCount = sudokuVarCount;
     
     // 计算数独CNF的大概子句数量
     // 每格约束: 81*9 + 81*36 = 729 + 2916 = 3645
@@ -299,8 +542,8 @@ bool saveSudokuCNF(SATList* cnf, const char* filename) {
     
     // 写入DIMACS格式头部
     fprintf(fp, "c Sudoku CNF generated by SAT solver\n");
-    fprintf(fp, "c Variables: 1-729 (row*81 + col*9 + num)\n");
-    fprintf(fp, "p cnf 729 %d\n", actualClauseCount);
+    fprintf(fp, "c Variables: 1-729 (row*81 + col*9 + num), auxiliary from 730\n");
+    fprintf(fp, "p cnf %d %d\n", sudokuVarCount, actualClauseCount);
     
     // 写入所有子句
     current = cnf;
@@ -316,83 +559,122 @@ bool saveSudokuCNF(SATList* cnf, const char* filename) {
     
     fclose(fp);
     cout << "CNF已保存到文件: " << filename << endl;
-    cout << "变量数: 729, 子句数: " << actualClauseCount << endl;
+    cout << "变量数: " << sudokuVarCount << ", 子句数: " << actualClauseCount << endl;
     return true;
 }
 
-void sudokuToCNF(int puzzle[N][N], SATList*& cnf) {
-    destroyClause(cnf); // 先清空
-    cnf = nullptr;
+// ==================== 顺序计数器AMO编码 ====================
+// "一组9个变量至多一真"的成对编码要36条二元子句；顺序计数器
+// 编码（Sinz 2005）引入8个辅助变量s_i（语义：x_1..x_i中已有真），
+// 只需3n-4=23条子句。全部约束组算下来子句数约降2/3，
+// BCP的监视工作集随之缩小。辅助变量编号从730起，
+// 谜题变量1..729的含义不变，解码方无需感知
+
+/** @brief 向CNF追加谜题提示对应的单文字子句 */
+static void addHintClauses(SATList*& cnf, uint8_t puzzle[N][N]) {
+	for (int i = 0; i < N; i++)
+		for (int j = 0; j < N; j++)
+			if (puzzle[i][j] != 0) {
+				SATNode* node = allocNode();
+				node->data = varIndex(i, j, puzzle[i][j]);
+				node->next = nullptr;
+				SATList* c = allocList();
+				c->head = node;
+				c->next = nullptr;
+				addClause(c, cnf);
+			}
+}
+
+void sudokuToCNF(uint8_t puzzle[N][N], SATList*& cnf) {
+	// 结构约束与谜题无关，进程内只构建一次。构建走扁平arena发射器
+	// （顺序push_back，无逐节点分配），再一次性转为链表作为缓存的
+	// 结构基底；此后每次编码只付一次整体复制加81条提示单子句的
+	// 代价。两种存储从同一发射器出活，编码不可能再分叉
+	static SATList* structural_base = sudokuBaseCNF().toSATList();
+
+	destroyClause(cnf);
+	cnf = nullptr;
+	CopyClause(cnf, structural_base);
+	addHintClauses(cnf, puzzle);
+}
+
+/**
+ * @brief 构建与谜题无关的数独结构约束（格/行/列/宫/对角线/窗口）
+ * @param arena 输出的扁平CNF
+ */
+/**
+ * @brief 顺序计数器编码的至多一真约束（扁平存储版）
+ * @details 与链表版emitAMOSequential同一编码，辅助变量
+ *          分配顺序一致，两种存储生成的公式等价
+ */
+static void emitAMOSequentialArena(CNFArena& arena, const int x[], int n, int& nextAux) {
+	if (n <= 1) return;
+	int s = nextAux;
+	nextAux += n - 1;
+
+	auto binary = [&arena](int a, int b) {
+		arena.beginClause();
+		arena.pushLiteral(a);
+		arena.pushLiteral(b);
+		arena.endClause();
+	};
+
+	binary(-x[0], s);
+	for (int i = 1; i < n - 1; i++) {
+		binary(-x[i], s + i);
+		binary(-(s + i - 1), s + i);
+		binary(-x[i], -(s + i - 1));
+	}
+	binary(-x[n - 1], -(s + n - 2));
+}
 
-    SATNode* node;
+static void buildSudokuStructure(CNFArena& arena) {
+	arena.clear();
+
+	int nextAux = 729 + 1;
+	int group[9];
 
 	// ---------- 格约束 ----------
 	for (int i = 0; i < N; i++) {
 		for (int j = 0; j < N; j++) {
 			// 每格至少填一个数字
-			SATList* cl = new SATList{ nullptr, nullptr };
-			SATNode* head = nullptr;
-			for (int num = 1; num <= 9; num++) {
-				node = new SATNode{ varIndex(i, j, num), nullptr };
-				node->next = head;
-				head = node;
-			}
-			cl->head = head;
-			addClause(cl, cnf);
-
-			// 每格只能填一个数字
-			for (int n1 = 1; n1 <= 8; n1++)
-				for (int n2 = n1 + 1; n2 <= 9; n2++) {
-					SATList* c = new SATList{ nullptr, nullptr };
-					c->head = new SATNode{ -varIndex(i,j,n1), new SATNode{-varIndex(i,j,n2), nullptr} };
-					addClause(c, cnf);
-				}
+			arena.beginClause();
+			for (int num = 1; num <= 9; num++)
+				arena.pushLiteral(varIndex(i, j, num));
+			arena.endClause();
+
+			// 每格只能填一个数字（顺序计数器编码）
+			for (int num = 1; num <= 9; num++)
+				group[num - 1] = varIndex(i, j, num);
+			emitAMOSequentialArena(arena, group, 9, nextAux);
 		}
 	}
 
 	// ---------- 行约束 ----------
 	for (int i = 0; i < N; i++) {
 		for (int num = 1; num <= 9; num++) {
-			// 每行至少有一个num
-			SATList* cl = new SATList{ nullptr, nullptr };
-			SATNode* head = nullptr;
-			for (int j = 0; j < N; j++) {
-				node = new SATNode{ varIndex(i,j,num), head };
-				head = node;
-			}
-			cl->head = head;
-			addClause(cl, cnf);
-
-			// 每行num只出现一次
-			for (int j1 = 0; j1 < N - 1; j1++)
-				for (int j2 = j1 + 1; j2 < N; j2++) {
-					SATList* c = new SATList{ nullptr, nullptr };
-					c->head = new SATNode{ -varIndex(i,j1,num), new SATNode{-varIndex(i,j2,num), nullptr} };
-					addClause(c, cnf);
-				}
+			arena.beginClause();
+			for (int j = 0; j < N; j++)
+				arena.pushLiteral(varIndex(i, j, num));
+			arena.endClause();
+
+			for (int j = 0; j < N; j++)
+				group[j] = varIndex(i, j, num);
+			emitAMOSequentialArena(arena, group, N, nextAux);
 		}
 	}
 
 	// ---------- 列约束 ----------
 	for (int j = 0; j < N; j++) {
 		for (int num = 1; num <= 9; num++) {
-			// 每列至少有一个num
-			SATList* cl = new SATList{ nullptr, nullptr };
-			SATNode* head = nullptr;
-			for (int i = 0; i < N; i++) {
-				node = new SATNode{ varIndex(i,j,num), head };
-				head = node;
-			}
-			cl->head = head;
-			addClause(cl, cnf);
-
-			// 每列num只出现一次
-			for (int i1 = 0; i1 < N - 1; i1++)
-				for (int i2 = i1 + 1; i2 < N; i2++) {
-					SATList* c = new SATList{ nullptr, nullptr };
-					c->head = new SATNode{ -varIndex(i1,j,num), new SATNode{-varIndex(i2,j,num), nullptr} };
-					addClause(c, cnf);
-				}
+			arena.beginClause();
+			for (int i = 0; i < N; i++)
+				arena.pushLiteral(varIndex(i, j, num));
+			arena.endClause();
+
+			for (int i = 0; i < N; i++)
+				group[i] = varIndex(i, j, num);
+			emitAMOSequentialArena(arena, group, N, nextAux);
 		}
 	}
 
@@ -400,198 +682,150 @@ void sudokuToCNF(int puzzle[N][N], SATList*& cnf) {
 	for (int boxRow = 0; boxRow < 3; boxRow++) {
 		for (int boxCol = 0; boxCol < 3; boxCol++) {
 			for (int num = 1; num <= 9; num++) {
-				// 至少有一个num
-				SATList* cl = new SATList{ nullptr, nullptr };
-				SATNode* head = nullptr;
+				arena.beginClause();
+				for (int i = 0; i < 3; i++)
+					for (int j = 0; j < 3; j++)
+						arena.pushLiteral(varIndex(boxRow * 3 + i, boxCol * 3 + j, num));
+				arena.endClause();
+
 				for (int i = 0; i < 3; i++)
 					for (int j = 0; j < 3; j++)
-						head = new SATNode{ varIndex(boxRow * 3 + i, boxCol * 3 + j, num), head };
-				cl->head = head;
-				addClause(cl, cnf);
-
-				// 只出现一次
-				for (int i1 = 0; i1 < 3; i1++)
-					for (int j1 = 0; j1 < 3; j1++)
-						for (int i2 = 0; i2 < 3; i2++)
-							for (int j2 = 0; j2 < 3; j2++) {
-								if (i1 == i2 && j1 >= j2) continue;
-								SATList* c = new SATList{ nullptr, nullptr };
-								c->head = new SATNode{ -varIndex(boxRow * 3 + i1, boxCol * 3 + j1, num),
-													   new SATNode{-varIndex(boxRow * 3 + i2, boxCol * 3 + j2, num), nullptr} };
-								addClause(c, cnf);
-							}
+						group[i * 3 + j] = varIndex(boxRow * 3 + i, boxCol * 3 + j, num);
+				emitAMOSequentialArena(arena, group, 9, nextAux);
 			}
 		}
 	}
 
-	// ---------- 撇对角线约束 ----------
+	// ---------- 主对角线约束 ----------
 	for (int num = 1; num <= 9; num++) {
-		// 主对角线
-		for (int i1 = 0; i1 < N - 1; i1++)
-			for (int i2 = i1 + 1; i2 < N; i2++) {
-				SATList* c = new SATList{ nullptr, nullptr };
-				c->head = new SATNode{ -varIndex(i1,i1,num), new SATNode{-varIndex(i2,i2,num), nullptr} };
-				addClause(c, cnf);
-			}
-		// 副对角线
-		/*for (int i1 = 0; i1 < N - 1; i1++)
-			for (int i2 = i1 + 1; i2 < N; i2++) {
-				SATList* c = new SATList{ nullptr, nullptr };
-				c->head = new SATNode{ -varIndex(i1,N - 1 - i1,num), new SATNode{-varIndex(i2,N - 1 - i2,num), nullptr} };
-				addClause(c, cnf);
-			}*/
+		for (int i = 0; i < N; i++)
+			group[i] = varIndex(i, i, num);
+		emitAMOSequentialArena(arena, group, N, nextAux);
 	}
 
 	// ---------- 上下窗口约束 ----------
-	int upper[9][2] = { {1,1},{1,2},{1,3},{2,1},{2,2},{2,3},{3,1},{3,2},{3,3} };
-	int lower[9][2] = { {5,5},{5,6},{5,7},{6,5},{6,6},{6,7},{7,5},{7,6},{7,7} };
 	for (int num = 1; num <= 9; num++) {
-		// 上窗口
-		for (int i = 0; i < 8; i++)
-			for (int j = i + 1; j < 9; j++) {
-				SATList* c = new SATList{ nullptr, nullptr };
-				c->head = new SATNode{ -varIndex(upper[i][0], upper[i][1], num),
-									   new SATNode{-varIndex(upper[j][0], upper[j][1], num), nullptr} };
-				addClause(c, cnf);
-			}
-		// 下窗口
-		for (int i = 0; i < 8; i++)
-			for (int j = i + 1; j < 9; j++) {
-				SATList* c = new SATList{ nullptr, nullptr };
-				c->head = new SATNode{ -varIndex(lower[i][0], lower[i][1], num),
-									   new SATNode{-varIndex(lower[j][0], lower[j][1], num), nullptr} };
-				addClause(c, cnf);
-			}
+		for (int i = 0; i < 9; i++)
+			group[i] = varIndex(upperWindow[i][0], upperWindow[i][1], num);
+		emitAMOSequentialArena(arena, group, 9, nextAux);
+
+		for (int i = 0; i < 9; i++)
+			group[i] = varIndex(lowerWindow[i][0], lowerWindow[i][1], num);
+		emitAMOSequentialArena(arena, group, 9, nextAux);
 	}
 
-	// ---------- 提示数字 ----------
+	sudokuVarCount = nextAux - 1;
+}
+
+/**
+ * @brief 返回数独结构约束的只读CNF实现
+ * @details C++11保证局部static初始化线程安全，
+ *          DualCore的两个线程可安全共享同一份数据
+ */
+const CNFArena& sudokuBaseCNF() {
+	static const CNFArena base = [] {
+		CNFArena arena;
+		buildSudokuStructure(arena);
+		return arena;
+	}();
+	return base;
+}
+
+/**
+ * @brief 将数独谜题转换为扁平存储的CNF公式实现
+ */
+void sudokuToCNF(uint8_t puzzle[N][N], CNFArena& arena) {
+	// 结构约束整体复制（两次vector拷贝），只追加提示单子句
+	CopyClause(arena, sudokuBaseCNF());
+
 	for (int i = 0; i < N; i++)
 		for (int j = 0; j < N; j++)
 			if (puzzle[i][j] != 0) {
-				SATList* c = new SATList{ nullptr, nullptr };
-				c->head = new SATNode{ varIndex(i,j,puzzle[i][j]), nullptr };
-				addClause(c, cnf);
+				arena.beginClause();
+				arena.pushLiteral(varIndex(i, j, puzzle[i][j]));
+				arena.endClause();
 			}
 }
 
-bool check(int solved[9][9], int ans[9][9])
+bool check(uint8_t solved[9][9], uint8_t ans[9][9])
 {
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 9; j++) {
-            if (solved[i][j] != ans[i][j]) {
-                return false;
-            }
-        }
-    }
-    return true;
+    // 两个网格内存布局连续，整体memcmp由编译器向量化为宽比较
+    return memcmp(solved, ans, sizeof(uint8_t) * 9 * 9) == 0;
 }
 /**
  * @brief 计算数独谜题的解的数量
  * @param puzzle 数独谜题，0表示空格
  * @param maxSolutions 最大解数限制，默认为2
  * @return 解的数量（最多计算到maxSolutions个）
- * @note 该函数使用手写栈实现的搜索算法，避免了递归调用可能导致的栈溢出
+ * @note 直接在9x9约束表示上做前向检查回溯计数：数独结构固定，
+ *       专用搜索免去CNF编码、阻塞子句与重复求解的全部开销，
+ *       典型谜题微秒级完成（generatePuzzle的唯一性检查仍走
+ *       增量SAT路径，两者互为对照）
  */
-int countSolutions(int puzzle[N][N], int maxSolutions) {
-    SATList* cnf = nullptr;
-    sudokuToCNF(puzzle, cnf);
-
-    // 设置数独求解的全局变量
-    setSudokuGlobals();
-
-    int solutionCount = 0;
-
-    // 手写栈实现，避免递归栈溢出
-    const int MAX_STACK_SIZE = 1000;
-    SATList* cnfStack[MAX_STACK_SIZE];      // CNF公式栈
-    int* valueStack[MAX_STACK_SIZE];        // 变量赋值栈
-    int stackTop = -1;                      // 栈顶指针
-
-    // 初始状态入栈
-    SATList* initialCNF = nullptr;
-    CopyClause(initialCNF, cnf);
-    int* initialValue = (int*)malloc(sizeof(int) * MAX_VAR);
-    for (int i = 0; i < MAX_VAR; i++) initialValue[i] = 1;
-
-    cnfStack[++stackTop] = initialCNF;
-    valueStack[stackTop] = initialValue;
-
-    while (stackTop >= 0 && solutionCount < maxSolutions) {
-        // 从栈中取出当前状态
-        SATList* currentCNF = cnfStack[stackTop];
-        int* currentValue = valueStack[stackTop];
-        stackTop--;
-
-        // 设置数独求解的全局变量
-        setSudokuGlobals();
-
-        // 使用OptimizedDPLL算法求解当前CNF
-        int result = DPLL_Optimized(currentCNF, currentValue);
-
-        if (result == 1) {
-            // 找到一个解
-            solutionCount++;
-
-            if (solutionCount < maxSolutions) {
-                // 需要继续搜索更多解，添加否定当前解的约束
-                SATList* nextCNF = nullptr;
-                CopyClause(nextCNF, cnf);
-
-                // 创建否定当前解的子句
-                SATList* negation = (SATList*)malloc(sizeof(SATList));
-                negation->head = nullptr;
-                negation->next = nullptr;
-
-                SATNode* negHead = nullptr;
-                // 遍历所有空格，构造否定解的约束
-                for (int row = 0; row < N; row++) {
-                    for (int col = 0; col < N; col++) {
-                        if (puzzle[row][col] == 0) {
-                            for (int num = 1; num <= 9; num++) {
-                                if (currentValue[varIndex(row, col, num)] == 1) {
-                                    SATNode* node = (SATNode*)malloc(sizeof(SATNode));
-                                    node->data = -varIndex(row, col, num);
-                                    node->next = negHead;
-                                    negHead = node;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
-
-                negation->head = negHead;
-                addClause(negation, nextCNF);
-
-                int* nextValue = (int*)malloc(sizeof(int) * MAX_VAR);
-                for (int i = 0; i < MAX_VAR; i++) nextValue[i] = 1;
-
-                // 检查栈容量，避免溢出
-                if (stackTop < MAX_STACK_SIZE - 1) {
-                    cnfStack[++stackTop] = nextCNF;
-                    valueStack[stackTop] = nextValue;
-                }
-                else {
-                    // 栈满，释放内存避免泄漏
-                    destroyClause(nextCNF);
-                    free(nextValue);
-                }
+int countSolutions(uint8_t puzzle[N][N], int maxSolutions) {
+    // 先校验提示自身无冲突（域初始化不检测已填数字间的矛盾）
+    uint8_t grid[N][N];
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            grid[i][j] = puzzle[i][j];
+
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            if (grid[i][j] != 0) {
+                int num = grid[i][j];
+                grid[i][j] = 0;
+                bool legal = isSafe(grid, i, j, num);
+                grid[i][j] = (uint8_t)num;
+                if (!legal) return 0;
             }
-        }
-
-        // 释放当前状态的内存
-        destroyClause(currentCNF);
-        free(currentValue);
-    }
 
-    // 清理栈中剩余的元素，防止内存泄漏
-    while (stackTop >= 0) {
-        destroyClause(cnfStack[stackTop]);
-        free(valueStack[stackTop]);
-        stackTop--;
+    ForwardCheck fc;
+    fc.init(grid);
+
+    // 提示多的谜题微秒级完成，线程开销得不偿失；只有空格极多、
+    // 枚举树真正庞大时才值得在根部按MRV格的候选分裂并行
+    int blanks = 0;
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            if (grid[i][j] == 0) blanks++;
+
+    const int PARALLEL_BLANKS = 60;
+    if (blanks < PARALLEL_BLANKS)
+        return countCompletions(grid, fc, maxSolutions);
+
+    int row, col;
+    findMostConstrainedCell(grid, fc, row, col);
+    if (row == -1) return 1;
+
+    // 根部每个候选数字一个线程，各自搜索独立子树；
+    // 跨线程解计数用于协作截断（第二解多半在另一子树）
+    std::atomic<int> global_count{0};
+    int results[9] = { 0 };
+    std::vector<std::thread> workers;
+    uint16_t cand = fc.dom[row][col];
+    int slot = 0;
+    while (cand != 0) {
+        int num = CTZ32(cand);
+        cand &= (uint16_t)(cand - 1);
+
+        workers.emplace_back([&, num, slot] {
+            uint8_t local[N][N];
+            for (int i = 0; i < N; i++)
+                for (int j = 0; j < N; j++)
+                    local[i][j] = grid[i][j];
+
+            ForwardCheck local_fc;
+            local_fc.init(local);
+            vector<pair<int, int>> placed;
+            if (placeWithPropagation(local, local_fc, row, col, num, placed))
+                results[slot] = countCompletions(local, local_fc, maxSolutions,
+                                                 &global_count);
+        });
+        slot++;
     }
+    for (size_t k = 0; k < workers.size(); k++) workers[k].join();
 
-    // 清理原始CNF
-    destroyClause(cnf);
-    return solutionCount;
+    int total = 0;
+    for (int k = 0; k < slot; k++) total += results[k];
+    return total < maxSolutions ? total : maxSolutions;
 }
\ No newline at end of file
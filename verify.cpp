@@ -4,17 +4,39 @@
 #include <string>
 #include <sstream>
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <thread>
 
-using namespace std;
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-struct Clause {
-    vector<int> literals;
-};
+using namespace std;
 
+// 子句采用扁平CSR存储（与求解器侧CNFArena同布局）：所有文字
+// 连续存放在literals中，子句i占据[offsets[i], offsets[i+1])。
+// 逐子句一个vector意味着每子句一次堆分配加一次指针追逐，验证
+// 的逐文字扫描变成纯顺序读后预取器可以全速工作
 struct CNF {
     int numVars;
     int numClauses;
-    vector<Clause> clauses;
+    // 文字在解析时预编码为 (变量号<<1)|符号位（负文字置位）：
+    // 验证内循环取变量号与符号只是一次移位一次按位与，
+    // 不再对每个文字算abs
+    vector<uint32_t> literals;  // 所有文字的连续存储（编码形式）
+    vector<uint32_t> offsets;   // 子句偏移，长度为子句数+1
+
+    int clauseCount() const { return (int)offsets.size() - 1; }
+
+    // 还原带符号DIMACS文字（诊断输出用）
+    static int decodeLit(uint32_t enc) {
+        int v = (int)(enc >> 1);
+        return (enc & 1) ? -v : v;
+    }
 };
 
 struct Solution {
@@ -23,166 +45,344 @@ struct Solution {
     double time;
 };
 
-// 解析CNF文件
-bool parseCNF(const string& filename, CNF& cnf) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "错误：无法打开CNF文件 " << filename << endl;
-        return false;
-    }
-    
-    string line;
-    bool headerFound = false;
-    
-    while (getline(file, line)) {
-        // 跳过注释行
-        if (line.empty() || line[0] == 'c') {
-            continue;
-        }
-        
-        // 解析头部行
-        if (line[0] == 'p') {
-            istringstream iss(line);
-            string p, cnf_str;
-            iss >> p >> cnf_str >> cnf.numVars >> cnf.numClauses;
-            headerFound = true;
-            continue;
+// 对内存中的DIMACS文本做手写整数扫描：逐字符解析，数字按
+// x=x*10+c-'0'累加，无istringstream、无locale查表（与求解器侧
+// parseDimacs同法），解析速度只受内存带宽限制
+static bool parseCNFText(const char* p, const char* end, CNF& cnf) {
+    // 整行跳注释交给memchr：libc按SIMD宽度扫描换行符
+    auto skipLine = [&p, end]() {
+        const char* nl = (const char*)memchr(p, '\n', end - p);
+        p = nl ? nl + 1 : end;
+    };
+
+    // 跳过注释行与空白，定位到问题行"p cnf V C"
+    while (p < end) {
+        if (*p == 'c') {
+            skipLine();
+        } else if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            ++p;
+        } else {
+            break;
         }
-        
-        if (!headerFound) {
-            continue;
+    }
+    if (p >= end || *p != 'p') return false;
+
+    // 跳过"p cnf"，停在第一个数字
+    while (p < end && (*p < '0' || *p > '9')) ++p;
+
+    // 读取下一个整数（含负号），容忍子句之间插入的注释行
+    auto readInt = [&p, end, &skipLine](int& out) -> bool {
+        for (;;) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+            if (p < end && *p == 'c') { skipLine(); continue; }
+            break;
         }
-        
-        // 解析子句
-        istringstream iss(line);
-        Clause clause;
-        int literal;
-        while (iss >> literal && literal != 0) {
-            clause.literals.push_back(literal);
+        if (p >= end) return false;
+        bool neg = (*p == '-');
+        if (neg) ++p;
+        int x = 0;
+        bool any = false;
+        while (p < end && *p >= '0' && *p <= '9') {
+            x = x * 10 + (*p++ - '0');
+            any = true;
         }
-        
-        if (!clause.literals.empty()) {
-            cnf.clauses.push_back(clause);
+        if (!any) return false;
+        out = neg ? -x : x;
+        return true;
+    };
+
+    if (!readInt(cnf.numVars) || !readInt(cnf.numClauses)) return false;
+
+    cnf.literals.clear();
+    cnf.offsets.assign(1, 0);
+    // 按头部声明的子句数预留，免去扁平池的多轮几何扩容搬移
+    // （文字数经验值按3-SAT估计，与求解器读取路径一致）
+    cnf.literals.reserve((size_t)cnf.numClauses * 3);
+    cnf.offsets.reserve((size_t)cnf.numClauses + 1);
+
+    // 读到文件尾为止；0结束一条子句，空子句照旧跳过
+    int number;
+    size_t clauseStart = 0;
+    while (readInt(number)) {
+        if (number != 0) {
+            uint32_t v = (uint32_t)(number > 0 ? number : -number);
+            cnf.literals.push_back((v << 1) | (number < 0 ? 1u : 0u));
+        } else if (cnf.literals.size() > clauseStart) {
+            cnf.offsets.push_back((uint32_t)cnf.literals.size());
+            clauseStart = cnf.literals.size();
         }
     }
-    
-    file.close();
     return true;
 }
 
+// 解析CNF文件
+bool parseCNF(const string& filename, CNF& cnf) {
+#ifndef _WIN32
+    // mmap整体映射为只读内存后单遍扫描：免去getline的逐行拷贝
+    // 与每个整数一次的istringstream构造
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "错误：无法打开CNF文件 " << filename << '\n';
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        cerr << "错误：无法打开CNF文件 " << filename << '\n';
+        close(fd);
+        return false;
+    }
+
+    const char* base = (const char*)mmap(nullptr, (size_t)st.st_size,
+                                         PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    // 提示内核顺序访问并立即发起预读：SEQUENTIAL加大预读窗口
+    // 并允许读过的页尽早回收，WILLNEED让预读与解析重叠，
+    // 冷缓存下首遍扫描不再逐页缺页停顿
+    madvise((void*)base, (size_t)st.st_size, MADV_SEQUENTIAL);
+    madvise((void*)base, (size_t)st.st_size, MADV_WILLNEED);
+
+    bool ok = parseCNFText(base, base + st.st_size, cnf);
+
+    munmap((void*)base, (size_t)st.st_size);
+    close(fd);
+    return ok;
+#else
+    // Windows：整体读入缓冲区后复用同一扫描器
+    FILE* fp = fopen(filename.c_str(), "rb");
+    if (!fp) {
+        cerr << "错误：无法打开CNF文件 " << filename << '\n';
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    vector<char> buf(size > 0 ? (size_t)size : 1);
+    size_t got = fread(buf.data(), 1, buf.size(), fp);
+    fclose(fp);
+
+    return parseCNFText(buf.data(), buf.data() + got, cnf);
+#endif
+}
+
 // 解析RES文件
+// 整体读入缓冲后指针扫描：RES的v行在大算例上有数百万个整数，
+// 逐行getline+istringstream的构造开销与CNF解析同病，同法医治
 bool parseRES(const string& filename, Solution& solution) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "错误：无法打开RES文件 " << filename << endl;
+    FILE* fp = fopen(filename.c_str(), "rb");
+    if (!fp) {
+        cerr << "错误：无法打开RES文件 " << filename << '\n';
         return false;
     }
-    
-    string line;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    vector<char> buf(size > 0 ? (size_t)size : 0);
+    size_t got = buf.empty() ? 0 : fread(buf.data(), 1, buf.size(), fp);
+    fclose(fp);
+    buf.resize(got);
+    buf.push_back('\0');    // strtod需要终止符
+
+    const char* p = buf.data();
+    const char* end = p + got;
     solution.satisfiable = false;
-    
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        
-        istringstream iss(line);
-        char prefix;
-        iss >> prefix;
-        
+    bool sawResult = false;
+
+    auto readInt = [&p, end](int& out) -> bool {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+        if (p >= end) return false;
+        bool neg = (*p == '-');
+        const char* digits = p + (neg ? 1 : 0);
+        if (digits >= end || *digits < '0' || *digits > '9') return false;
+        p = digits;
+        int x = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            x = x * 10 + (*p++ - '0');
+        }
+        out = neg ? -x : x;
+        return true;
+    };
+
+    while (p < end) {
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            ++p;
+            continue;
+        }
+        char prefix = *p++;
+
         if (prefix == 's') {
             int result;
-            iss >> result;
-            solution.satisfiable = (result == 1);
+            if (readInt(result)) {
+                solution.satisfiable = (result == 1);
+                sawResult = true;
+            }
         }
         else if (prefix == 'v' && solution.satisfiable) {
             // 解析变量赋值
             int var;
-            while (iss >> var && var != 0) {
-                int varIndex = abs(var);
+            while (readInt(var) && var != 0) {
+                size_t varIndex = (size_t)abs(var);
                 if (varIndex < solution.assignment.size()) {
                     solution.assignment[varIndex] = (var > 0) ? 1 : -1;
                 }
             }
         }
         else if (prefix == 't') {
-            iss >> solution.time;
+            char* after = nullptr;
+            solution.time = strtod(p, &after);
+            if (after != nullptr) p = after;
+            // 不可满足的结果没有v行可读：s与t都到手后剩余内容
+            // 与验证无关，直接停止扫描
+            if (sawResult && !solution.satisfiable) break;
+        }
+        else {
+            // 未知前缀：整行跳过
+            const char* nl = (const char*)memchr(p, '\n', end - p);
+            p = nl ? nl + 1 : end;
         }
     }
-    
-    file.close();
     return true;
 }
 
 // 验证解是否满足CNF
 bool verifySolution(const CNF& cnf, const Solution& solution) {
     if (!solution.satisfiable) {
-        cout << "解标记为不可满足，无需验证赋值。" << endl;
+        cout << "解标记为不可满足，无需验证赋值。" << '\n';
         return true; // 我们无法验证不可满足的情况，只能相信求解器
     }
     
     // 检查赋值数组大小
     if (solution.assignment.size() <= cnf.numVars) {
-        cerr << "错误：赋值数组大小不足" << endl;
+        cerr << "错误：赋值数组大小不足" << '\n';
         return false;
     }
     
-    cout << "开始验证解..." << endl;
-    cout << "变量数：" << cnf.numVars << endl;
-    cout << "子句数：" << cnf.numClauses << endl;
-    
-    int satisfiedClauses = 0;
-    vector<int> unsatisfiedClauses;
+    cout << "开始验证解..." << '\n';
+    cout << "变量数：" << cnf.numVars << '\n';
+    cout << "子句数：" << cnf.numClauses << '\n';
     
-    // 检查每个子句
-    for (int i = 0; i < cnf.clauses.size(); ++i) {
-        const Clause& clause = cnf.clauses[i];
-        bool clauseSatisfied = false;
-        
-        // 检查子句中的每个文字
-        for (int literal : clause.literals) {
-            int var = abs(literal);
-            int value = solution.assignment[var];
-            
-            // 检查文字是否满足
-            if ((literal > 0 && value == 1) || (literal < 0 && value == -1)) {
-                clauseSatisfied = true;
-                break;
+    // 未满足子句只展示前SHOW_MAX条：常见情形是零条未满足，
+    // 不为此在扫描循环里做无界push_back，只留计数加定长首样本
+    const int SHOW_MAX = 10;
+
+    // 赋值表打包成位集：posTrue记变量为真，assignedBits记已赋值
+    // （未赋值变量不满足任何文字，负文字也不行，需单独一位区分）。
+    // 4字节/变量缩为2位/变量，整张表在大规模实例上也能常驻L1
+    const size_t words = ((size_t)cnf.numVars >> 6) + 1;
+    vector<uint64_t> posTrue(words, 0), assignedBits(words, 0);
+    for (int v = 1; v <= cnf.numVars; ++v) {
+        if (solution.assignment[v] == 1) posTrue[v >> 6] |= 1ULL << (v & 63);
+        if (solution.assignment[v] != 0) assignedBits[v >> 6] |= 1ULL << (v & 63);
+    }
+
+    // 检查子句区间[from,to)：CSR布局下逐文字扫描是对literals的
+    // 线性顺序读。文字求值无分支：从位集取真值位与符号位异或
+    // （正文字要真位、负文字要假位），再与已赋值位相与，按位累积
+    // 整条子句。不在首个满足文字处break——每文字的条件跳转是
+    // 数据相关的稳定误预测源，而无分支累积让编译器能按多文字展开
+    const int totalClauses = cnf.clauseCount();
+    auto scanRange = [&cnf, &posTrue, &assignedBits, SHOW_MAX](
+                         int from, int to,
+                         long long& unsatCount, vector<int>& firstUnsat) {
+        // 单个编码文字的满足位（0或1）
+        auto evalLit = [&posTrue, &assignedBits](uint32_t enc) -> uint64_t {
+            uint32_t var = enc >> 1;
+            uint64_t bit = posTrue[var >> 6] >> (var & 63);
+            uint64_t assignedBit = assignedBits[var >> 6] >> (var & 63);
+            return (assignedBit & (bit ^ (enc & 1))) & 1;
+        };
+
+        const uint32_t* lits = cnf.literals.data();
+        for (int i = from; i < to; ++i) {
+            uint32_t b = cnf.offsets[i];
+            uint32_t len = cnf.offsets[i + 1] - b;
+            uint64_t sat;
+
+            // 二、三元子句按长度走直线特化：实际算例里这两档占
+            // 绝大多数（3-SAT与数独的AMO对子），免去循环计数器
+            // 与回边，求值全在寄存器里展开
+            switch (len) {
+                case 2:
+                    sat = evalLit(lits[b]) | evalLit(lits[b + 1]);
+                    break;
+                case 3:
+                    sat = evalLit(lits[b]) | evalLit(lits[b + 1]) | evalLit(lits[b + 2]);
+                    break;
+                default:
+                    sat = 0;
+                    for (uint32_t k = b; k < b + len; ++k) {
+                        sat |= evalLit(lits[k]);
+                    }
+                    break;
+            }
+
+            if (sat == 0) {
+                if ((int)firstUnsat.size() < SHOW_MAX) firstUnsat.push_back(i);
+                unsatCount++;
             }
         }
-        
-        if (clauseSatisfied) {
-            satisfiedClauses++;
-        } else {
-            unsatisfiedClauses.push_back(i);
+    };
+
+    // 子句检查彼此独立且只读赋值位集，按区间切给多个线程：
+    // 每线程攒本地计数与前SHOW_MAX个未满足下标，结束后按区间
+    // 顺序合并即全局最靠前的样本。小实例不值得开线程
+    long long unsatCount = 0;
+    vector<int> firstUnsat;
+    unsigned hw = thread::hardware_concurrency();
+    int numThreads = (hw >= 2 && totalClauses >= 65536) ? (int)hw : 1;
+    if (numThreads <= 1) {
+        scanRange(0, totalClauses, unsatCount, firstUnsat);
+    } else {
+        vector<long long> localCount(numThreads, 0);
+        vector<vector<int>> localUnsat(numThreads);
+        vector<thread> workers;
+        int chunk = (totalClauses + numThreads - 1) / numThreads;
+        for (int t = 0; t < numThreads; ++t) {
+            int from = t * chunk;
+            int to = min(totalClauses, from + chunk);
+            workers.emplace_back(scanRange, from, to,
+                                 ref(localCount[t]), ref(localUnsat[t]));
+        }
+        for (auto& w : workers) w.join();
+        for (int t = 0; t < numThreads; ++t) {
+            unsatCount += localCount[t];
+            for (int idx : localUnsat[t]) {
+                if ((int)firstUnsat.size() < SHOW_MAX) firstUnsat.push_back(idx);
+            }
         }
     }
-    
-    cout << "满足的子句数：" << satisfiedClauses << "/" << cnf.clauses.size() << endl;
-    
-    if (unsatisfiedClauses.empty()) {
-        cout << "✓ 验证成功！所有子句都被满足。" << endl;
+
+    cout << "满足的子句数：" << (totalClauses - unsatCount) << "/" << totalClauses << '\n';
+
+    if (unsatCount == 0) {
+        cout << "✓ 验证成功！所有子句都被满足。" << '\n';
         return true;
     } else {
-        cout << "✗ 验证失败！以下子句未被满足：" << endl;
-        for (int i = 0; i < min(10, (int)unsatisfiedClauses.size()); ++i) {
-            int clauseIndex = unsatisfiedClauses[i];
+        cout << "✗ 验证失败！以下子句未被满足：" << '\n';
+        for (size_t i = 0; i < firstUnsat.size(); ++i) {
+            int clauseIndex = firstUnsat[i];
             cout << "子句 " << clauseIndex + 1 << ": ";
-            for (int literal : cnf.clauses[clauseIndex].literals) {
-                cout << literal << " ";
+            for (uint32_t k = cnf.offsets[clauseIndex]; k < cnf.offsets[clauseIndex + 1]; ++k) {
+                cout << CNF::decodeLit(cnf.literals[k]) << " ";
             }
-            cout << "0" << endl;
-            
+            cout << "0" << '\n';
+
             // 显示该子句中各文字的赋值情况
             cout << "  文字赋值：";
-            for (int literal : cnf.clauses[clauseIndex].literals) {
+            for (uint32_t k = cnf.offsets[clauseIndex]; k < cnf.offsets[clauseIndex + 1]; ++k) {
+                int literal = CNF::decodeLit(cnf.literals[k]);
                 int var = abs(literal);
                 int value = solution.assignment[var];
                 cout << literal << "(" << value << ") ";
             }
-            cout << endl;
+            cout << '\n';
         }
         
-        if (unsatisfiedClauses.size() > 10) {
-            cout << "... 还有 " << unsatisfiedClauses.size() - 10 << " 个子句未满足" << endl;
+        if (unsatCount > (long long)firstUnsat.size()) {
+            cout << "... 还有 " << unsatCount - (long long)firstUnsat.size() << " 个子句未满足" << '\n';
         }
         
         return false;
@@ -193,30 +393,34 @@ bool verifySolution(const CNF& cnf, const Solution& solution) {
 void showAssignmentSample(const Solution& solution, int maxShow = 20) {
     if (!solution.satisfiable) return;
     
-    cout << "变量赋值示例（前" << maxShow << "个变量）：" << endl;
+    cout << "变量赋值示例（前" << maxShow << "个变量）：" << '\n';
     for (int i = 1; i <= min(maxShow, (int)solution.assignment.size() - 1); ++i) {
         if (solution.assignment[i] != 0) {
             cout << "x" << i << "=" << (solution.assignment[i] == 1 ? "true" : "false") << " ";
-            if (i % 10 == 0) cout << endl;
+            if (i % 10 == 0) cout << '\n';
         }
     }
-    cout << endl;
+    cout << '\n';
 }
 
 int main(int argc, char* argv[]) {
+    // 本工具输出只走cout/cerr，不与stdio混写：解除同步后
+    // iostream走自己的缓冲，endl已全部换成'\n'免逐行flush
+    ios::sync_with_stdio(false);
+
     if (argc != 3) {
-        cout << "使用方法: " << argv[0] << " <cnf文件> <res文件>" << endl;
-        cout << "例如: " << argv[0] << " problem.cnf problem.res" << endl;
+        cout << "使用方法: " << argv[0] << " <cnf文件> <res文件>" << '\n';
+        cout << "例如: " << argv[0] << " problem.cnf problem.res" << '\n';
         return 1;
     }
     
     string cnfFile = argv[1];
     string resFile = argv[2];
     
-    cout << "=== SAT求解结果验证工具 ===" << endl;
-    cout << "CNF文件: " << cnfFile << endl;
-    cout << "RES文件: " << resFile << endl;
-    cout << endl;
+    cout << "=== SAT求解结果验证工具 ===" << '\n';
+    cout << "CNF文件: " << cnfFile << '\n';
+    cout << "RES文件: " << resFile << '\n';
+    cout << '\n';
     
     // 解析CNF文件
     CNF cnf;
@@ -231,9 +435,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    cout << "求解结果: " << (solution.satisfiable ? "可满足" : "不可满足") << endl;
-    cout << "求解时间: " << solution.time << "ms" << endl;
-    cout << endl;
+    cout << "求解结果: " << (solution.satisfiable ? "可满足" : "不可满足") << '\n';
+    cout << "求解时间: " << solution.time << "ms" << '\n';
+    cout << '\n';
     
     // 显示赋值示例
     if (solution.satisfiable) {
@@ -243,13 +447,13 @@ int main(int argc, char* argv[]) {
     // 验证解
     bool isValid = verifySolution(cnf, solution);
     
-    cout << endl;
-    cout << "=== 验证结果 ===" << endl;
+    cout << '\n';
+    cout << "=== 验证结果 ===" << '\n';
     if (isValid) {
-        cout << "✓ 解是正确的！" << endl;
+        cout << "✓ 解是正确的！" << '\n';
         return 0;
     } else {
-        cout << "✗ 解不正确或不完整！" << endl;
+        cout << "✗ 解不正确或不完整！" << '\n';
         return 1;
     }
 }